@@ -7,212 +7,152 @@
 
 #include <ADBTelemetryContainer.h>
 
-int ADBTelemetryContainer::size()
-{
-    return ADB_CONTAINER_SIZE;
-}
-
-unsigned char* ADBTelemetryContainer::getArray()
-{
-    return &telemetry[0];
-}
-
 unsigned long ADBTelemetryContainer::getUpTime()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[0];
-    ((unsigned char *)&ulong)[2] = telemetry[1];
-    ((unsigned char *)&ulong)[1] = telemetry[2];
-    ((unsigned char *)&ulong)[0] = telemetry[3];
-    return ulong;
+    return UpTimeField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setUpTime(unsigned long ulong)
 {
-    *((unsigned long *)&(telemetry[0])) = ulong;
-    telemetry[0] = ((unsigned char *)&ulong)[3];
-    telemetry[1] = ((unsigned char *)&ulong)[2];
-    telemetry[2] = ((unsigned char *)&ulong)[1];
-    telemetry[3] = ((unsigned char *)&ulong)[0];
+    UpTimeField::set(telemetry, ulong);
 }
 
 bool ADBTelemetryContainer::getBusStatus()
 {
-    return ((telemetry[7] & 0x02) != 0);
+    return BusStatusField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setBusStatus(bool bval)
 {
-    telemetry[7] &= (~0x02);
-    telemetry[7] |= bval ? 0x02 : 0x00;
+    BusStatusField::set(telemetry, bval);
 }
 
 bool ADBTelemetryContainer::getTorquerXStatus()
 {
-    return ((telemetry[7] & 0x04) != 0);
+    return TorquerXStatusField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setTorquerXStatus(bool bval)
 {
-    telemetry[7] &= (~0x04);
-    telemetry[7] |= bval ? 0x04 : 0x00;
+    TorquerXStatusField::set(telemetry, bval);
 }
 
 bool ADBTelemetryContainer::getTorquerYStatus()
 {
-    return ((telemetry[7] & 0x08) != 0);
+    return TorquerYStatusField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setTorquerYStatus(bool bval)
 {
-    telemetry[7] &= (~0x08);
-    telemetry[7] |= bval ? 0x08 : 0x00;
+    TorquerYStatusField::set(telemetry, bval);
 }
 
 bool ADBTelemetryContainer::getTorquerZStatus()
 {
-    return ((telemetry[7] & 0x10) != 0);
+    return TorquerZStatusField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setTorquerZStatus(bool bval)
 {
-    telemetry[7] &= (~0x10);
-    telemetry[7] |= bval ? 0x10 : 0x00;
+    TorquerZStatusField::set(telemetry, bval);
 }
 
 bool ADBTelemetryContainer::getTmpStatus()
 {
-    return ((telemetry[7] & 0x01) != 0);
+    return TmpStatusField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setTmpStatus(bool bval)
 {
-    telemetry[7] &= (~0x01);
-    telemetry[7] |= bval ? 0x01 : 0x00;
+    TmpStatusField::set(telemetry, bval);
 }
 
 signed short ADBTelemetryContainer::getBusCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[16];
-    ((unsigned char *)&ushort)[0] = telemetry[17];
-    return ushort;
+    return BusCurrentField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setBusCurrent(signed short ushort)
 {
-    telemetry[16] = ((unsigned char *)&ushort)[1];
-    telemetry[17] = ((unsigned char *)&ushort)[0];
+    BusCurrentField::set(telemetry, ushort);
 }
 
 unsigned short ADBTelemetryContainer::getBusVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[24];
-    ((unsigned char *)&ushort)[0] = telemetry[25];
-    return ushort;
+    return BusVoltageField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setBusVoltage(unsigned short ushort)
 {
-    telemetry[24] = ((unsigned char *)&ushort)[1];
-    telemetry[25] = ((unsigned char *)&ushort)[0];
+    BusVoltageField::set(telemetry, ushort);
 }
 
 signed short ADBTelemetryContainer::getTorquerXCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[14];
-    ((unsigned char *)&ushort)[0] = telemetry[15];
-    return ushort;
+    return TorquerXCurrentField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setTorquerXCurrent(signed short ushort)
 {
-    telemetry[14] = ((unsigned char *)&ushort)[1];
-    telemetry[15] = ((unsigned char *)&ushort)[0];
+    TorquerXCurrentField::set(telemetry, ushort);
 }
 
 unsigned short ADBTelemetryContainer::getTorquerXVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[22];
-    ((unsigned char *)&ushort)[0] = telemetry[23];
-    return ushort;
+    return TorquerXVoltageField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setTorquerXVoltage(unsigned short ushort)
 {
-    telemetry[22] = ((unsigned char *)&ushort)[1];
-    telemetry[23] = ((unsigned char *)&ushort)[0];
+    TorquerXVoltageField::set(telemetry, ushort);
 }
 
 signed short ADBTelemetryContainer::getTorquerYCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[12];
-    ((unsigned char *)&ushort)[0] = telemetry[13];
-    return ushort;
+    return TorquerYCurrentField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setTorquerYCurrent(signed short ushort)
 {
-    telemetry[12] = ((unsigned char *)&ushort)[1];
-    telemetry[13] = ((unsigned char *)&ushort)[0];
+    TorquerYCurrentField::set(telemetry, ushort);
 }
 
 unsigned short ADBTelemetryContainer::getTorquerYVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[20];
-    ((unsigned char *)&ushort)[0] = telemetry[21];
-    return ushort;
+    return TorquerYVoltageField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setTorquerYVoltage(unsigned short ushort)
 {
-    telemetry[20] = ((unsigned char *)&ushort)[1];
-    telemetry[21] = ((unsigned char *)&ushort)[0];
+    TorquerYVoltageField::set(telemetry, ushort);
 }
 
 signed short ADBTelemetryContainer::getTorquerZCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[16];
-    ((unsigned char *)&ushort)[0] = telemetry[17];
-    return ushort;
+    return TorquerZCurrentField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setTorquerZCurrent(signed short ushort)
 {
-    telemetry[10] = ((unsigned char *)&ushort)[1];
-    telemetry[11] = ((unsigned char *)&ushort)[0];
+    TorquerZCurrentField::set(telemetry, ushort);
 }
 
 unsigned short ADBTelemetryContainer::getTorquerZVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[18];
-    ((unsigned char *)&ushort)[0] = telemetry[19];
-    return ushort;
+    return TorquerZVoltageField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setTorquerZVoltage(unsigned short ushort)
 {
-    telemetry[18] = ((unsigned char *)&ushort)[1];
-    telemetry[19] = ((unsigned char *)&ushort)[0];
+    TorquerZVoltageField::set(telemetry, ushort);
 }
 
 signed short ADBTelemetryContainer::getTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[8];
-    ((unsigned char *)&ushort)[0] = telemetry[9];
-    return ushort;
+    return TemperatureField::get(telemetry);
 }
 
 void ADBTelemetryContainer::setTemperature(signed short ushort)
 {
-    telemetry[8] = ((unsigned char *)&ushort)[1];
-    telemetry[9] = ((unsigned char *)&ushort)[0];
+    TemperatureField::set(telemetry, ushort);
 }
@@ -0,0 +1,54 @@
+/*
+ *  BigEndian.h
+ *
+ *  Access to big-endian 16 and 32 bits values at any address of a byte array
+ *  (telemetry arrays, FRAM records). memcpy() copies the bytes to and from an
+ *  aligned variable, which is then swapped to or from the byte order of the MCU.
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef BIGENDIAN_H_
+#define BIGENDIAN_H_
+
+#include <string.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define BIGENDIAN_SWAP16(x)     __builtin_bswap16(x)
+    #define BIGENDIAN_SWAP32(x)     __builtin_bswap32(x)
+#else
+    // Swap with shifts when the builtins are not available
+    #define BIGENDIAN_SWAP16(x)     ((uint16_t)(((x) << 8) | ((x) >> 8)))
+    #define BIGENDIAN_SWAP32(x)     ((((x) & 0xFF) << 24) | (((x) & 0xFF00) << 8) \
+                                     | (((x) >> 8) & 0xFF00) | ((x) >> 24))
+#endif
+
+static inline uint16_t BigEndianLoad16(const unsigned char *data)
+{
+    uint16_t value;
+    memcpy(&value, data, 2);
+    return BIGENDIAN_SWAP16(value);
+}
+
+static inline uint32_t BigEndianLoad32(const unsigned char *data)
+{
+    uint32_t value;
+    memcpy(&value, data, 4);
+    return BIGENDIAN_SWAP32(value);
+}
+
+static inline void BigEndianStore16(unsigned char *data, uint16_t value)
+{
+    value = BIGENDIAN_SWAP16(value);
+    memcpy(data, &value, 2);
+}
+
+static inline void BigEndianStore32(unsigned char *data, uint32_t value)
+{
+    value = BIGENDIAN_SWAP32(value);
+    memcpy(data, &value, 4);
+}
+
+#endif /* BIGENDIAN_H_ */
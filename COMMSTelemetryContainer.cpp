@@ -7,574 +7,432 @@
 
 #include <COMMSTelemetryContainer.h>
 
-int COMMSTelemetryContainer::size()
-{
-    return COMMS_CONTAINER_SIZE;
-}
-
-unsigned char* COMMSTelemetryContainer::getArray()
-{
-    return &telemetry[0];
-}
-
 unsigned long COMMSTelemetryContainer::getUpTime()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[0];
-    ((unsigned char *)&ulong)[2] = telemetry[1];
-    ((unsigned char *)&ulong)[1] = telemetry[2];
-    ((unsigned char *)&ulong)[0] = telemetry[3];
-    return ulong;
+    return UpTimeField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setUpTime(unsigned long ulong)
 {
-    *((unsigned long *)&(telemetry[0])) = ulong;
-    telemetry[0] = ((unsigned char *)&ulong)[3];
-    telemetry[1] = ((unsigned char *)&ulong)[2];
-    telemetry[2] = ((unsigned char *)&ulong)[1];
-    telemetry[3] = ((unsigned char *)&ulong)[0];
+    UpTimeField::set(telemetry, ulong);
 }
 
 bool COMMSTelemetryContainer::getB1Status()
 {
-    return ((telemetry[8] & 0x10) != 0);
+    return B1StatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB1Status(bool bval)
 {
-    telemetry[8] &= (~0x10);
-    telemetry[8] |= bval ? 0x10 : 0x00;
+    B1StatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getB2Status()
 {
-    return ((telemetry[8] & 0x20) != 0);
+    return B2StatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB2Status(bool bval)
 {
-    telemetry[8] &= (~0x20);
-    telemetry[8] |= bval ? 0x20 : 0x00;
+    B2StatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getB3Status()
 {
-    return ((telemetry[8] & 0x40) != 0);
+    return B3StatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB3Status(bool bval)
 {
-    telemetry[8] &= (~0x40);
-    telemetry[8] |= bval ? 0x40 : 0x00;
+    B3StatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getB4Status()
 {
-    return ((telemetry[8] & 0x80) != 0);
+    return B4StatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB4Status(bool bval)
 {
-    telemetry[8] &= (~0x80);
-    telemetry[8] |= bval ? 0x80 : 0x00;
+    B4StatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getIntBStatus()
 {
-    return ((telemetry[7] & 0x01) != 0);
+    return IntBStatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setIntBStatus(bool bval)
 {
-    telemetry[7] &= (~0x01);
-    telemetry[7] |= bval ? 0x01 : 0x00;
+    IntBStatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getURBStatus()
 {
-    return ((telemetry[7] & 0x02) != 0);
+    return URBStatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setURBStatus(bool bval)
 {
-    telemetry[7] &= (~0x02);
-    telemetry[7] |= bval ? 0x02 : 0x00;
+    URBStatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getSAYpStatus()
 {
-    return ((telemetry[7] & 0x04) != 0);
+    return SAYpStatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAYpStatus(bool bval)
 {
-    telemetry[7] &= (~0x04);
-    telemetry[7] |= bval ? 0x04 : 0x00;
+    SAYpStatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getSAYmStatus()
 {
-    return ((telemetry[7] & 0x08) != 0);
+    return SAYmStatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAYmStatus(bool bval)
 {
-    telemetry[7] &= (~0x08);
-    telemetry[7] |= bval ? 0x08 : 0x00;
+    SAYmStatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getSAXpStatus()
 {
-    return ((telemetry[7] & 0x10) != 0);
+    return SAXpStatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAXpStatus(bool bval)
 {
-    telemetry[7] &= (~0x10);
-    telemetry[7] |= bval ? 0x10 : 0x00;
+    SAXpStatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getSAXmStatus()
 {
-    return ((telemetry[7] & 0x20) != 0);
+    return SAXmStatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAXmStatus(bool bval)
 {
-    telemetry[7] &= (~0x20);
-    telemetry[7] |= bval ? 0x20 : 0x00;
+    SAXmStatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getBattStatus()
 {
-    return ((telemetry[7] & 0x40) != 0);
+    return BattStatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setBattStatus(bool bval)
 {
-    telemetry[7] &= (~0x40);
-    telemetry[7] |= bval ? 0x40 : 0x00;
+    BattStatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getSAYpTmpStatus()
 {
-    return ((telemetry[8] & 0x01) != 0);
+    return SAYpTmpStatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAYpTmpStatus(bool bval)
 {
-    telemetry[8] &= (~0x01);
-    telemetry[8] |= bval ? 0x01 : 0x00;
+    SAYpTmpStatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getSAYmTmpStatus()
 {
-    return ((telemetry[8] & 0x02) != 0);
+    return SAYmTmpStatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAYmTmpStatus(bool bval)
 {
-    telemetry[8] &= (~0x02);
-    telemetry[8] |= bval ? 0x02 : 0x00;
+    SAYmTmpStatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getSAXpTmpStatus()
 {
-    return ((telemetry[8] & 0x04) != 0);
+    return SAXpTmpStatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAXpTmpStatus(bool bval)
 {
-    telemetry[8] &= (~0x04);
-    telemetry[8] |= bval ? 0x04 : 0x00;
+    SAXpTmpStatusField::set(telemetry, bval);
 }
 
 bool COMMSTelemetryContainer::getSAXmTmpStatus()
 {
-    return ((telemetry[8] & 0x08) != 0);
+    return SAXmTmpStatusField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAXmTmpStatus(bool bval)
 {
-    telemetry[8] &= (~0x08);
-    telemetry[8] |= bval ? 0x08 : 0x00;
+    SAXmTmpStatusField::set(telemetry, bval);
 }
 
 signed short COMMSTelemetryContainer::getIntBCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[58];
-    ((unsigned char *)&ushort)[0] = telemetry[59];
-    return ushort;
+    return IntBCurrentField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setIntBCurrent(signed short ushort)
 {
-    telemetry[58] = ((unsigned char *)&ushort)[1];
-    telemetry[59] = ((unsigned char *)&ushort)[0];
+    IntBCurrentField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getIntBVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[60];
-    ((unsigned char *)&ushort)[0] = telemetry[61];
-    return ushort;
+    return IntBVoltageField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setIntBVoltage(unsigned short ushort)
 {
-    telemetry[60] = ((unsigned char *)&ushort)[1];
-    telemetry[61] = ((unsigned char *)&ushort)[0];
+    IntBVoltageField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getURBCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[62];
-    ((unsigned char *)&ushort)[0] = telemetry[63];
-    return ushort;
+    return URBCurrentField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setURBCurrent(signed short ushort)
 {
-    telemetry[62] = ((unsigned char *)&ushort)[1];
-    telemetry[63] = ((unsigned char *)&ushort)[0];
+    URBCurrentField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getURBVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[64];
-    ((unsigned char *)&ushort)[0] = telemetry[65];
-    return ushort;
+    return URBVoltageField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setURBVoltage(unsigned short ushort)
 {
-    telemetry[64] = ((unsigned char *)&ushort)[1];
-    telemetry[65] = ((unsigned char *)&ushort)[0];
+    URBVoltageField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getB1Current()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[33];
-    ((unsigned char *)&ushort)[0] = telemetry[34];
-    return ushort;
+    return B1CurrentField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB1Current(signed short ushort)
 {
-    telemetry[33] = ((unsigned char *)&ushort)[1];
-    telemetry[34] = ((unsigned char *)&ushort)[0];
+    B1CurrentField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getB1Voltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[41];
-    ((unsigned char *)&ushort)[0] = telemetry[42];
-    return ushort;
+    return B1VoltageField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB1Voltage(unsigned short ushort)
 {
-    telemetry[41] = ((unsigned char *)&ushort)[1];
-    telemetry[42] = ((unsigned char *)&ushort)[0];
+    B1VoltageField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getB2Current()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[35];
-    ((unsigned char *)&ushort)[0] = telemetry[36];
-    return ushort;
+    return B2CurrentField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB2Current(signed short ushort)
 {
-    telemetry[35] = ((unsigned char *)&ushort)[1];
-    telemetry[36] = ((unsigned char *)&ushort)[0];
+    B2CurrentField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getB2Voltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[43];
-    ((unsigned char *)&ushort)[0] = telemetry[44];
-    return ushort;
+    return B2VoltageField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB2Voltage(unsigned short ushort)
 {
-    telemetry[43] = ((unsigned char *)&ushort)[1];
-    telemetry[44] = ((unsigned char *)&ushort)[0];
+    B2VoltageField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getB3Current()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[37];
-    ((unsigned char *)&ushort)[0] = telemetry[38];
-    return ushort;
+    return B3CurrentField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB3Current(signed short ushort)
 {
-    telemetry[37] = ((unsigned char *)&ushort)[1];
-    telemetry[38] = ((unsigned char *)&ushort)[0];
+    B3CurrentField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getB3Voltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[45];
-    ((unsigned char *)&ushort)[0] = telemetry[46];
-    return ushort;
+    return B3VoltageField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB3Voltage(unsigned short ushort)
 {
-    telemetry[45] = ((unsigned char *)&ushort)[1];
-    telemetry[46] = ((unsigned char *)&ushort)[0];
+    B3VoltageField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getB4Current()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[39];
-    ((unsigned char *)&ushort)[0] = telemetry[40];
-    return ushort;
+    return B4CurrentField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB4Current(signed short ushort)
 {
-    telemetry[39] = ((unsigned char *)&ushort)[1];
-    telemetry[40] = ((unsigned char *)&ushort)[0];
+    B4CurrentField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getB4Voltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[47];
-    ((unsigned char *)&ushort)[0] = telemetry[48];
-    return ushort;
+    return B4VoltageField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setB4Voltage(unsigned short ushort)
 {
-    telemetry[47] = ((unsigned char *)&ushort)[1];
-    telemetry[48] = ((unsigned char *)&ushort)[0];
+    B4VoltageField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getSAYpCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[17];
-    ((unsigned char *)&ushort)[0] = telemetry[18];
-    return ushort;
+    return SAYpCurrentField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAYpCurrent(signed short ushort)
 {
-    telemetry[17] = ((unsigned char *)&ushort)[1];
-    telemetry[18] = ((unsigned char *)&ushort)[0];
+    SAYpCurrentField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getSAYpVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[25];
-    ((unsigned char *)&ushort)[0] = telemetry[26];
-    return ushort;
+    return SAYpVoltageField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAYpVoltage(unsigned short ushort)
 {
-    telemetry[25] = ((unsigned char *)&ushort)[1];
-    telemetry[26] = ((unsigned char *)&ushort)[0];
+    SAYpVoltageField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getSAYmCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[19];
-    ((unsigned char *)&ushort)[0] = telemetry[20];
-    return ushort;
+    return SAYmCurrentField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAYmCurrent(signed short ushort)
 {
-    telemetry[19] = ((unsigned char *)&ushort)[1];
-    telemetry[20] = ((unsigned char *)&ushort)[0];
+    SAYmCurrentField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getSAYmVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[27];
-    ((unsigned char *)&ushort)[0] = telemetry[28];
-    return ushort;
+    return SAYmVoltageField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAYmVoltage(unsigned short ushort)
 {
-    telemetry[27] = ((unsigned char *)&ushort)[1];
-    telemetry[28] = ((unsigned char *)&ushort)[0];
+    SAYmVoltageField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getSAXpCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[21];
-    ((unsigned char *)&ushort)[0] = telemetry[22];
-    return ushort;
+    return SAXpCurrentField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAXpCurrent(signed short ushort)
 {
-    telemetry[21] = ((unsigned char *)&ushort)[1];
-    telemetry[22] = ((unsigned char *)&ushort)[0];
+    SAXpCurrentField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getSAXpVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[29];
-    ((unsigned char *)&ushort)[0] = telemetry[30];
-    return ushort;
+    return SAXpVoltageField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAXpVoltage(unsigned short ushort)
 {
-    telemetry[29] = ((unsigned char *)&ushort)[1];
-    telemetry[30] = ((unsigned char *)&ushort)[0];
+    SAXpVoltageField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getSAXmCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[23];
-    ((unsigned char *)&ushort)[0] = telemetry[24];
-    return ushort;
+    return SAXmCurrentField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAXmCurrent(signed short ushort)
 {
-    telemetry[23] = ((unsigned char *)&ushort)[1];
-    telemetry[24] = ((unsigned char *)&ushort)[0];
+    SAXmCurrentField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getSAXmVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[31];
-    ((unsigned char *)&ushort)[0] = telemetry[32];
-    return ushort;
+    return SAXmVoltageField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAXmVoltage(unsigned short ushort)
 {
-    telemetry[31] = ((unsigned char *)&ushort)[1];
-    telemetry[32] = ((unsigned char *)&ushort)[0];
+    SAXmVoltageField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getBattVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[49];
-    ((unsigned char *)&ushort)[0] = telemetry[50];
-    return ushort;
+    return BattVoltageField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setBattVoltage(unsigned short ushort)
 {
-    telemetry[49] = ((unsigned char *)&ushort)[1];
-    telemetry[50] = ((unsigned char *)&ushort)[0];
+    BattVoltageField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getBattTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[53];
-    ((unsigned char *)&ushort)[0] = telemetry[54];
-    return ushort;
+    return BattTemperatureField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setBattTemperature(signed short ushort)
 {
-    telemetry[53] = ((unsigned char *)&ushort)[1];
-    telemetry[54] = ((unsigned char *)&ushort)[0];
+    BattTemperatureField::set(telemetry, ushort);
 }
 
 unsigned short COMMSTelemetryContainer::getBattCapacity()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[51];
-    ((unsigned char *)&ushort)[0] = telemetry[52];
-    return ushort;
+    return BattCapacityField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setBattCapacity(unsigned short ushort)
 {
-    telemetry[51] = ((unsigned char *)&ushort)[1];
-    telemetry[52] = ((unsigned char *)&ushort)[0];
+    BattCapacityField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getSAYpTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[9];
-    ((unsigned char *)&ushort)[0] = telemetry[10];
-    return ushort;
+    return SAYpTemperatureField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAYpTemperature(signed short ushort)
 {
-    telemetry[9] = ((unsigned char *)&ushort)[1];
-    telemetry[10] = ((unsigned char *)&ushort)[0];
+    SAYpTemperatureField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getSAYmTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[11];
-    ((unsigned char *)&ushort)[0] = telemetry[12];
-    return ushort;
+    return SAYmTemperatureField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAYmTemperature(signed short ushort)
 {
-    telemetry[11] = ((unsigned char *)&ushort)[1];
-    telemetry[12] = ((unsigned char *)&ushort)[0];
+    SAYmTemperatureField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getSAXpTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[13];
-    ((unsigned char *)&ushort)[0] = telemetry[14];
-    return ushort;
+    return SAXpTemperatureField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAXpTemperature(signed short ushort)
 {
-    telemetry[13] = ((unsigned char *)&ushort)[1];
-    telemetry[14] = ((unsigned char *)&ushort)[0];
+    SAXpTemperatureField::set(telemetry, ushort);
 }
 
 signed short COMMSTelemetryContainer::getSAXmTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[15];
-    ((unsigned char *)&ushort)[0] = telemetry[16];
-    return ushort;
+    return SAXmTemperatureField::get(telemetry);
 }
 
 void COMMSTelemetryContainer::setSAXmTemperature(signed short ushort)
 {
-    telemetry[15] = ((unsigned char *)&ushort)[1];
-    telemetry[16] = ((unsigned char *)&ushort)[0];
+    SAXmTemperatureField::set(telemetry, ushort);
 }
@@ -9,6 +9,7 @@
 #define COMMSTELEMETRYCONTAINER_H_
 
 #include "TelemetryContainer.h"
+#include "TelemetryField.h"
 
 #define COMMS_CONTAINER_SIZE  66
 class COMMSTelemetryContainer : public TelemetryContainer
@@ -17,8 +18,54 @@ protected:
     unsigned char telemetry[COMMS_CONTAINER_SIZE];
 
 public:
-    virtual int size();
-    virtual unsigned char * getArray();
+    // Fields of the telemetry array (see TelemetryField.h)
+    typedef TelemetryField<unsigned long, 0, 4> UpTimeField;
+    typedef TelemetryFlag<7, 0x01> IntBStatusField;
+    typedef TelemetryFlag<7, 0x02> URBStatusField;
+    typedef TelemetryFlag<7, 0x04> SAYpStatusField;
+    typedef TelemetryFlag<7, 0x08> SAYmStatusField;
+    typedef TelemetryFlag<7, 0x10> SAXpStatusField;
+    typedef TelemetryFlag<7, 0x20> SAXmStatusField;
+    typedef TelemetryFlag<7, 0x40> BattStatusField;
+    typedef TelemetryFlag<8, 0x01> SAYpTmpStatusField;
+    typedef TelemetryFlag<8, 0x02> SAYmTmpStatusField;
+    typedef TelemetryFlag<8, 0x04> SAXpTmpStatusField;
+    typedef TelemetryFlag<8, 0x08> SAXmTmpStatusField;
+    typedef TelemetryFlag<8, 0x10> B1StatusField;
+    typedef TelemetryFlag<8, 0x20> B2StatusField;
+    typedef TelemetryFlag<8, 0x40> B3StatusField;
+    typedef TelemetryFlag<8, 0x80> B4StatusField;
+    typedef TelemetryField<signed short, 9, 2> SAYpTemperatureField;
+    typedef TelemetryField<signed short, 11, 2> SAYmTemperatureField;
+    typedef TelemetryField<signed short, 13, 2> SAXpTemperatureField;
+    typedef TelemetryField<signed short, 15, 2> SAXmTemperatureField;
+    typedef TelemetryField<signed short, 17, 2> SAYpCurrentField;
+    typedef TelemetryField<signed short, 19, 2> SAYmCurrentField;
+    typedef TelemetryField<signed short, 21, 2> SAXpCurrentField;
+    typedef TelemetryField<signed short, 23, 2> SAXmCurrentField;
+    typedef TelemetryField<unsigned short, 25, 2> SAYpVoltageField;
+    typedef TelemetryField<unsigned short, 27, 2> SAYmVoltageField;
+    typedef TelemetryField<unsigned short, 29, 2> SAXpVoltageField;
+    typedef TelemetryField<unsigned short, 31, 2> SAXmVoltageField;
+    typedef TelemetryField<signed short, 33, 2> B1CurrentField;
+    typedef TelemetryField<signed short, 35, 2> B2CurrentField;
+    typedef TelemetryField<signed short, 37, 2> B3CurrentField;
+    typedef TelemetryField<signed short, 39, 2> B4CurrentField;
+    typedef TelemetryField<unsigned short, 41, 2> B1VoltageField;
+    typedef TelemetryField<unsigned short, 43, 2> B2VoltageField;
+    typedef TelemetryField<unsigned short, 45, 2> B3VoltageField;
+    typedef TelemetryField<unsigned short, 47, 2> B4VoltageField;
+    typedef TelemetryField<unsigned short, 49, 2> BattVoltageField;
+    typedef TelemetryField<unsigned short, 51, 2> BattCapacityField;
+    typedef TelemetryField<signed short, 53, 2> BattTemperatureField;
+    typedef TelemetryField<signed short, 58, 2> IntBCurrentField;
+    typedef TelemetryField<unsigned short, 60, 2> IntBVoltageField;
+    typedef TelemetryField<signed short, 62, 2> URBCurrentField;
+    typedef TelemetryField<unsigned short, 64, 2> URBVoltageField;
+
+    // The telemetry array and its size
+    virtual int size() { return COMMS_CONTAINER_SIZE; }
+    virtual unsigned char * getArray() { return telemetry; }
 
     unsigned long getUpTime();
     void setUpTime(unsigned long ulong);
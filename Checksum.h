@@ -0,0 +1,48 @@
+/*
+ *  Checksum.h
+ *
+ *  CRC-32 (ISO 3309, the one of Ethernet and zip) of FRAM blocks and records.
+ *  It uses the CRC32 module of the MSP432 when it gives the same result as the
+ *  table-driven implementation (checked by ChecksumInit()), else the table.
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef CHECKSUM_H_
+#define CHECKSUM_H_
+
+#define CHECKSUM_CRC32_INIT         0xFFFFFFFF
+
+/**
+ *
+ *  Select the implementation, call it once in main.cpp (before using the FRAM)
+ *
+ */
+void ChecksumInit();
+
+/**
+ *
+ *  CRC-32 of a block of data. A block in several parts is done by passing the
+ *  result of each part to the next one. The result isn't inverted at the end
+ *  (it's only compared, never sent).
+ *
+ *  Parameters:
+ *      unsigned long crc               CHECKSUM_CRC32_INIT, or the CRC of the previous part
+ *      unsigned char *data             The data
+ *      int size                        The size of the data
+ *  Returns:
+ *      ChecksumCRC32()                 CRC-32 of the previous parts and the data
+ *
+ */
+unsigned long ChecksumCRC32(unsigned long crc, unsigned char *data, int size);
+
+/**
+ *
+ *  Returns:
+ *      ChecksumHardware()              true if the CRC32 module is used
+ *
+ */
+bool ChecksumHardware();
+
+#endif /* CHECKSUM_H_ */
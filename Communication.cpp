@@ -9,21 +9,510 @@
 #define COMMUNICATION_DEBUG
 
 #include "Communication.h"
+#include "TimeoutEstimator.h"
+#include "DirtyLines.h"
 //TODO: #include "OBCDataContainer.h"
 #include "PQ9Frame.h"
 #include "PQ9Bus.h"
 #include "Console.h"
 #include "ResetService.h"
 #include "DelfiPQcore.h"
+#include "Task.h"
+#include <string.h>
 
 #define MAX_PAYLOAD_SIZE            255
+#define MAX_QUEUED_PAYLOAD_SIZE     16  // Payload of a request waiting in the queue
 #define PING_SERVICE                17
 #define HOUSEKEEPING_SERVICE        3
 
-volatile bool cmdReceivedFlag;
-DataFrame *receivedFrame;
+// A request which is sent over the bus and waits for its reply
+typedef struct CommRequest
+{
+    RequestHandle handle;
+    volatile char status;               // SERVICE_PENDING until the request is completed
+    volatile bool sent;                 // false while the request waits in the queue
+    RequestPriority priority;
+    Address destination;
+    unsigned char serviceNum;
+    volatile unsigned long remainingMS; // Decremented by the Timer32 interrupt
+    unsigned long startMS;
+    RequestCallback callback;
+    unsigned char *replyBuffer;         // Buffer of the caller for the payload of the reply (can be 0),
+    unsigned int replyMaxSize;          // see RequestReply()
+    unsigned int replySize;
+    unsigned char payloadSize;          // Copy of the payload while the request is queued
+    unsigned char payload[MAX_QUEUED_PAYLOAD_SIZE];
+} CommRequest;
+
+// Outstanding requests: at most one per destination and service, so a reply is
+// matched to its request by the source address and the service number.
+// The requests which are not sent yet form the priority queue.
+CommRequest requests[COMMUNICATION_MAX_REQUESTS];
+RequestHandle lastHandle;
+
+// Priority of every request type
+const RequestPriority requestPriorities[REQUEST_TYPES] = {
+    PING_PRIORITY,          // PING_REQUEST
+    HOUSEKEEPING_PRIORITY,  // HOUSEKEEPING_REQUEST
+    CRITICAL_PRIORITY,      // POWER_REQUEST
+    DEPLOY_PRIORITY         // DEPLOY_REQUEST
+};
+
+// Only one frame is transmitted at a time
+volatile bool busBusy;
+PQ9Frame queuedFrame;
+
+// Received frames: single-producer (receivedCommand() interrupt) / single-consumer
+// (CommunicationPoll() in the task) ring. rxHead is only written by the producer and
+// rxTail only by the consumer, both are free-running and masked with RX_RING_SIZE - 1.
+// The slots are whole frames, so a reply stays valid after the driver reuses its buffer.
+//
+// Memory ordering: the Cortex-M4 has a single core and no data cache, and the producer
+// is an interrupt of that core, so it runs to completion between two instructions of the
+// consumer and both see the memory accesses in program order. The indexes are aligned
+// 32-bit words, which are read and written in one access (never torn). Only the compiler
+// could reorder the accesses to a slot around the index which publishes or releases it:
+// the indexes are volatile and __DMB() (a barrier for the compiler and the bus) separates
+// writing a slot from moving rxHead, and reading a slot from moving rxTail.
+// tests/ReceiveRingStressTest.cpp runs the ring with a producer thread.
+PQ9Frame rxRing[RX_RING_SIZE];
+volatile unsigned long rxHead;
+volatile unsigned long rxTail;
+unsigned long rxNext;           // Next frame to process, rxTail follows once it's processed
+volatile unsigned long rxOverflowCount;
+unsigned long unsolicitedCount;
+
+// Handler of the requests received from the other modules (see CommunicationSetRequestHandler())
+void (*requestHandler)(DataFrame &request);
+
+// Set by the interrupts when there is something for CommunicationPoll() to do
+volatile bool commEvent;
+
+// The 1ms tick runs while a request is pending, CommunicationSleep() is waiting,
+// a StateMachine() tick is running (CommunicationStartTick() ~ CommunicationEndTick())
+// or a task holds it (CommunicationHoldClock() ~ CommunicationReleaseClock())
+volatile int tickUsers;
+volatile unsigned long commTimeMS;      // Only counts while the tick runs
+bool tickClock;                         // The StateMachine() tick holds the 1ms tick
+volatile unsigned long sleepRemainingMS;
+
+// Retry policy of every request type and time budget of the current tick
+RetryPolicy retryPolicies[REQUEST_TYPES] = {
+    {1, 0, true},       // PING_REQUEST
+    {1, 10, true},      // HOUSEKEEPING_REQUEST
+    {2, 20, true},      // POWER_REQUEST: setting a line twice is harmless
+    {1, 50, false}      // DEPLOY_REQUEST: never repeat an actuation which may be done
+};
+unsigned long tickStartMS;
+unsigned long tickBudgetMS = COMMUNICATION_DEFAULT_BUDGET_MS;
+unsigned long retryCount;
+volatile unsigned long timeoutCount;
+volatile unsigned long droppedCount;
+
+// Telemetry sweep in progress, see RequestTelemetrySweep()
+TelemetrySweepSlot *sweepSlots;
+int sweepSize;
 extern PQ9Bus pq9bus; // Defined in main.cpp
 extern ResetService reset;
+extern Task communicationTask;
+
+
+/**
+ *
+ *  Disable the interrupts, return true if they were already disabled
+ *
+ */
+bool EnterCritical()
+{
+    return MAP_Interrupt_disableMaster();
+}
+
+
+/**
+ *
+ *  Enable the interrupts again, unless they were disabled before EnterCritical()
+ *
+ */
+void ExitCritical(bool wasDisabled)
+{
+    if (!wasDisabled)
+    {
+        MAP_Interrupt_enableMaster();
+    }
+}
+
+
+/**
+ *
+ *  Start the 1ms tick (the timer uses FCLOCK), call it with interrupts disabled
+ *
+ */
+void StartTick()
+{
+    if (tickUsers++ == 0)
+    {
+        MAP_Timer32_setCount(TIMER32_1_BASE, FCLOCK / 1000);
+        MAP_Timer32_startTimer(TIMER32_1_BASE, false);
+    }
+}
+
+
+/**
+ *
+ *  Stop the 1ms tick when nothing else is waiting
+ *
+ */
+void ReleaseTick()
+{
+    bool wasDisabled = EnterCritical();
+
+    if (--tickUsers == 0)
+    {
+        MAP_Timer32_haltTimer(TIMER32_1_BASE);
+    }
+    ExitCritical(wasDisabled);
+}
+
+
+/**
+ *
+ *  Complete a request, called by CommunicationPoll() in the task
+ *
+ */
+void CompleteRequest(CommRequest &request, char status, DataFrame *reply)
+{
+    ReleaseTick();
+
+    if (status == SERVICE_RESPONSE_REPLY)
+    {
+        // Kick internal watchdog (time window: 178s)
+        reset.kickInternalWatchDog();
+    }
+
+    // Any frame from the service is a round-trip time measurement
+    if (reply != 0)
+    {
+        TimeoutUpdate(request.destination, request.serviceNum, commTimeMS - request.startMS);
+    }
+    else if (request.sent)
+    {
+        TimeoutExpired(request.destination, request.serviceNum);
+        timeoutCount++;
+    }
+    else
+    {
+        // Deferred by higher priority requests until its time limit expired
+        droppedCount++;
+    }
+
+    // The frame is in the receive ring, which reuses its slot once it's processed:
+    // the payload is copied to the buffer of the caller (never more than its size)
+    if ((reply != 0) && (request.replyBuffer != 0))
+    {
+        request.replySize = reply->getPayloadSize();
+        if (request.replySize > request.replyMaxSize)
+        {
+            request.replySize = request.replyMaxSize;
+        }
+        memcpy(request.replyBuffer, reply->getPayload(), request.replySize);
+    }
+    request.status = status;
+
+    if (request.callback)
+    {
+        request.callback(request.handle, status, reply);
+    }
+}
+
+
+/**
+ *
+ *  Check whether a request with a higher priority than the given one is pending
+ *  (queued or sent): then the request has to wait in the queue
+ *
+ */
+bool HigherPriorityPending(RequestPriority priority)
+{
+    for (int i = 0; i < COMMUNICATION_MAX_REQUESTS; i++)
+    {
+        if ((requests[i].status == SERVICE_PENDING) && (requests[i].priority < priority))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**
+ *
+ *  Find the next queued request which can be sent: highest priority first,
+ *  then the oldest one. Call it with interrupts disabled.
+ *
+ */
+CommRequest *NextQueuedRequest()
+{
+    CommRequest *next = 0;
+
+    for (int i = 0; i < COMMUNICATION_MAX_REQUESTS; i++)
+    {
+        if ((requests[i].status != SERVICE_PENDING) || requests[i].sent)
+        {
+            continue;
+        }
+        if ((next == 0) || (requests[i].priority < next->priority)
+            || ((requests[i].priority == next->priority) && (requests[i].handle < next->handle)))
+        {
+            next = &requests[i];
+        }
+    }
+
+    if ((next == 0) || HigherPriorityPending(next->priority))
+    {
+        return 0;
+    }
+    return next;
+}
+
+
+/**
+ *
+ *  Mark a request as sent, call it with interrupts disabled
+ *
+ */
+void MarkSent(CommRequest &request)
+{
+    busBusy = true;
+    request.sent = true;
+    request.startMS = commTimeMS;
+}
+
+
+/**
+ *
+ *  Send the queued requests which are allowed to go on the bus.
+ *  It's called after every transmission and completion.
+ *
+ */
+void PumpQueue()
+{
+    CommRequest *next;
+    bool wasDisabled;
+
+    for (;;)
+    {
+        wasDisabled = EnterCritical();
+        next = busBusy ? 0 : NextQueuedRequest();
+        if (next == 0)
+        {
+            ExitCritical(wasDisabled);
+            return;
+        }
+        MarkSent(*next);
+        ExitCritical(wasDisabled);
+
+        queuedFrame.setSource(OBC);
+        queuedFrame.setDestination(next->destination);
+        queuedFrame.setPayloadSize(next->payloadSize);
+        memcpy(queuedFrame.getPayload(), next->payload, next->payloadSize);
+        pq9bus.transmit(queuedFrame);
+        busBusy = false;
+    }
+}
+
+
+/**
+ *
+ *  Interrupt service routine of Timer32_1, it ticks every 1ms when a request is pending.
+ *  The expired requests are completed by CommunicationPoll().
+ *
+ */
+void CommunicationTimerISR()
+{
+    MAP_Timer32_clearInterruptFlag(TIMER32_1_BASE);
+    commTimeMS++;
+
+    if ((sleepRemainingMS > 0) && (--sleepRemainingMS == 0))
+    {
+        ReleaseTick();
+        commEvent = true;
+    }
+
+    for (int i = 0; i < COMMUNICATION_MAX_REQUESTS; i++)
+    {
+        if ((requests[i].status == SERVICE_PENDING) && (requests[i].remainingMS > 0)
+            && (--requests[i].remainingMS == 0))
+        {
+            commEvent = true;
+        }
+    }
+}
+
+
+/**
+ *
+ *  Pass a request received from another module to the request handler.
+ *  On the target it's the CommandHandler of DelfiPQcore (see main.cpp): it finds
+ *  the service and sends the reply from its own task. The tasks are cooperative
+ *  and PumpQueue() sends a whole frame before it returns, so the reply never
+ *  overlaps a frame of the queue.
+ *
+ */
+void ServeRequest(DataFrame &frame)
+{
+    if (requestHandler == 0)
+    {
+#ifdef COMMUNICATION_DEBUG
+        Console::log("Request (service %d) from %d dropped, no handler", (int) frame.getPayload()[0], (int) frame.getSource());
+#endif
+        return;
+    }
+    requestHandler(frame);
+}
+
+
+/**
+ *
+ *  Route a received frame by its type: a request goes to the request handler,
+ *  a reply (or an error) to the request it answers
+ *
+ */
+void ProcessFrame(DataFrame &frame)
+{
+    if (frame.getPayloadSize() < 2)
+    {
+        return;
+    }
+
+    if (frame.getPayload()[1] == SERVICE_RESPONSE_REQUEST)
+    {
+        ServeRequest(frame);
+        return;
+    }
+
+    for (int i = 0; i < COMMUNICATION_MAX_REQUESTS; i++)
+    {
+        if ((requests[i].status != SERVICE_PENDING) || !requests[i].sent
+            || (frame.getSource() != requests[i].destination)
+            || (frame.getPayload()[0] != requests[i].serviceNum))
+        {
+            continue;
+        }
+
+        // Check the reply
+        if (frame.getPayload()[1] == SERVICE_RESPONSE_REPLY)
+        {
+            CompleteRequest(requests[i], SERVICE_RESPONSE_REPLY, &frame);
+        }
+        else
+        {
+            CompleteRequest(requests[i], SERVICE_RESPONSE_ERROR, &frame);
+        }
+        return;
+    }
+
+    // Not a reply to a pending request (e.g. it arrived after its time limit)
+    unsolicitedCount++;
+#ifdef COMMUNICATION_DEBUG
+    Console::log("Unsolicited reply (service %d) from %d", (int) frame.getPayload()[0], (int) frame.getSource());
+#endif
+}
+
+
+/**
+ *
+ *  Process the received frames and the expired requests
+ *  Please read Communication.h
+ *
+ */
+void CommunicationPoll()
+{
+    // Consume the received frames, the slot is released after the frame is processed.
+    // rxNext moves first: a callback or a service may call CommunicationPoll() again.
+    while (rxNext != rxHead)
+    {
+        __DMB(); // Read the frame only after reading rxHead
+        DataFrame &frame = rxRing[rxNext & (RX_RING_SIZE - 1)];
+        rxNext++;
+        ProcessFrame(frame);
+        __DMB(); // Release the slot only after the frame is read
+        rxTail = rxNext;
+    }
+
+    for (int i = 0; i < COMMUNICATION_MAX_REQUESTS; i++)
+    {
+        if ((requests[i].status == SERVICE_PENDING) && (requests[i].remainingMS == 0))
+        {
+            CompleteRequest(requests[i], SERVICE_NO_RESPONSE, 0);
+        }
+    }
+
+    // Deferred requests may be allowed on the bus now
+    PumpQueue();
+}
+
+
+/**
+ *
+ *  Sleep in low-power mode until an interrupt has something for CommunicationPoll()
+ *
+ */
+void SleepUntilEvent()
+{
+    // Interrupts are disabled while checking the flag, so the event can't slip in
+    // between the check and the sleep. A pending interrupt still wakes the CPU up
+    // and is served as soon as the interrupts are enabled again.
+    MAP_Interrupt_disableMaster();
+    if (!commEvent)
+    {
+        MAP_PCM_gotoLPM0();
+    }
+    MAP_Interrupt_enableMaster();
+}
+
+
+/**
+ *
+ *  Find the request which belongs to a handle, return 0 if the handle is invalid
+ *
+ */
+CommRequest *FindRequest(RequestHandle handle)
+{
+    CommRequest *request;
+
+    if (handle < 0)
+    {
+        return 0;
+    }
+
+    request = &requests[handle % COMMUNICATION_MAX_REQUESTS];
+    return (request->handle == handle) ? request : 0;
+}
+
+
+/**
+ *
+ *  Initialize the request engine
+ *  Please read Communication.h
+ *
+ */
+void CommunicationInit()
+{
+    for (int i = 0; i < COMMUNICATION_MAX_REQUESTS; i++)
+    {
+        requests[i].handle = INVALID_REQUEST_HANDLE;
+        requests[i].status = SERVICE_NO_RESPONSE;
+    }
+    tickUsers = 0;
+    busBusy = false;
+    rxHead = 0;
+    rxTail = 0;
+    rxNext = 0;
+
+    MAP_Timer32_initModule(TIMER32_1_BASE, TIMER32_PRESCALER_1, TIMER32_32BIT, TIMER32_PERIODIC_MODE);
+    MAP_Timer32_registerInterrupt(TIMER32_1_INTERRUPT, CommunicationTimerISR);
+    MAP_Timer32_enableInterrupt(TIMER32_1_BASE);
+}
 
 
 /**
@@ -35,96 +524,496 @@ extern ResetService reset;
  */
 void receivedCommand(DataFrame &newFrame)
 {
-    cmdReceivedFlag = true;
-    receivedFrame = &newFrame;
+    PQ9Frame *slot;
+
+    // The ring is full: the frame is lost
+    if (rxHead - rxTail >= RX_RING_SIZE)
+    {
+        rxOverflowCount++;
+        commEvent = true;
+        return;
+    }
+
+    slot = &rxRing[rxHead & (RX_RING_SIZE - 1)];
+    slot->setSource(newFrame.getSource());
+    slot->setDestination(newFrame.getDestination());
+    slot->setPayloadSize(newFrame.getPayloadSize());
+    memcpy(slot->getPayload(), newFrame.getPayload(), newFrame.getPayloadSize());
+
+    __DMB(); // Publish the frame before moving rxHead
+    rxHead = rxHead + 1;
+    commEvent = true;
+
+    // A request from another module is answered without waiting for StateMachine()
+    communicationTask.notify();
 }
 
 
 /**
  *
- *  Transmit a pq9frame within the time limit
+ *  Set the handler of the requests received from the other modules
+ *  Please read Communication.h
  *
- *  Parameters:
- *      PQ9Frame sentFrame          The frame which is transmitted
- *      unsigned long timeLimitMS   The time limit
- *  External variables used:
- *      bool cmdReceivedFlag        It indicates whether OBC gets a reply
- *      PQ9Frame *receivedFrame     Address of the reply
+ */
+void CommunicationSetRequestHandler(void (*handler)(DataFrame &request))
+{
+    requestHandler = handler;
+}
+
+
+/**
+ *
+ *  Send a frame over the bus without waiting for the reply
+ *  Please read Communication.h
  *
  */
-void TransmitWithTimeLimit(PQ9Frame sentFrame, unsigned long timeLimitMS)
+RequestHandle RequestFrameAsync(RequestType type, PQ9Frame &sentFrame, unsigned long timeLimitMS,
+                                RequestCallback callback)
 {
-    unsigned long count;
+    Address destination = (Address)sentFrame.getDestination();
+    unsigned char serviceNum = sentFrame.getPayload()[0];
+    CommRequest *request = 0;
+    bool sendNow;
+    bool wasDisabled;
 
-    // Send the frame
-    cmdReceivedFlag = false;
-    pq9bus.transmit(sentFrame);
+    sentFrame.setSource(OBC);
 
-    // Wait until timeLimitMS passes or the reply arrives
-    count = FCLOCK/(1000L/timeLimitMS); // The timer uses FCLOCK
-    MAP_Timer32_initModule(TIMER32_1_BASE, TIMER32_PRESCALER_1, TIMER32_32BIT, TIMER32_PERIODIC_MODE);
-    MAP_Timer32_setCount(TIMER32_1_BASE, count);
-    MAP_Timer32_startTimer(TIMER32_1_BASE, true);
-    while ((MAP_Timer32_getValue(TIMER32_1_BASE) > 0) && (cmdReceivedFlag == false));
+    wasDisabled = EnterCritical();
+
+    // Take a free slot, only one request per destination and service can be pending
+    for (int i = 0; i < COMMUNICATION_MAX_REQUESTS; i++)
+    {
+        if (requests[i].status == SERVICE_PENDING)
+        {
+            if ((requests[i].destination == destination) && (requests[i].serviceNum == serviceNum))
+            {
+                request = 0;
+                break;
+            }
+        }
+        else if (request == 0)
+        {
+            request = &requests[i];
+        }
+    }
+
+    if (request == 0)
+    {
+        ExitCritical(wasDisabled);
+#ifdef COMMUNICATION_DEBUG
+        Console::log("RequestFrameAsync(): no free slot for destination %d", destination);
+#endif
+        return INVALID_REQUEST_HANDLE;
+    }
+
+    // The handle also tells in which slot the request is
+    lastHandle = (lastHandle + COMMUNICATION_MAX_REQUESTS) & 0x3FFFFFFF;
+
+    // Register the request before transmitting, the reply can arrive at any time
+    request->handle = lastHandle + (request - requests);
+    request->priority = requestPriorities[type];
+    request->destination = destination;
+    request->serviceNum = serviceNum;
+    request->remainingMS = TimeoutGetLimit(destination, serviceNum, timeLimitMS);
+    if (request->remainingMS == 0)
+    {
+        request->remainingMS = 1;
+    }
+    request->callback = callback;
+    request->replyBuffer = 0;
+    request->replySize = 0;
+    request->sent = false;
+
+    // The frame is sent at once when nothing more important (or older with the
+    // same priority) is waiting, otherwise the payload is kept in the queue
+    sendNow = !busBusy && !HigherPriorityPending(request->priority);
+    for (int i = 0; sendNow && (i < COMMUNICATION_MAX_REQUESTS); i++)
+    {
+        if ((requests[i].status == SERVICE_PENDING) && !requests[i].sent
+            && (requests[i].priority == request->priority))
+        {
+            sendNow = false;
+        }
+    }
 
+    if (!sendNow && (sentFrame.getPayloadSize() > MAX_QUEUED_PAYLOAD_SIZE))
+    {
+        ExitCritical(wasDisabled);
 #ifdef COMMUNICATION_DEBUG
-    Console::log("TransmitWithTimeLimit(): response count: %d", count - MAP_Timer32_getValue(TIMER32_1_BASE));
+        Console::log("RequestFrameAsync(): payload too big for the queue: %d bytes", sentFrame.getPayloadSize());
 #endif
+        return INVALID_REQUEST_HANDLE;
+    }
+
+    if (sendNow)
+    {
+        MarkSent(*request);
+    }
+    else
+    {
+        request->payloadSize = sentFrame.getPayloadSize();
+        memcpy(request->payload, sentFrame.getPayload(), request->payloadSize);
+    }
+
+    request->status = SERVICE_PENDING;
+    StartTick();
+    ExitCritical(wasDisabled);
+
+    if (sendNow)
+    {
+        // Send the frame
+        pq9bus.transmit(sentFrame);
+        busBusy = false;
+
+        // Requests queued during the transmission
+        PumpQueue();
+    }
+
+    return request->handle;
 }
 
 
 /**
  *
- *  Send a frame over the bus and get the reply
+ *  Send a frame over the bus without waiting for the reply
  *  Please read Communication.h
  *
  */
-char RequestReply(Address destination, unsigned char sentSize, unsigned char *sentPayload,
-                  unsigned char *receivedSize, unsigned char **receivedPayload,
-                  unsigned long timeLimitMS)
+RequestHandle RequestReplyAsync(RequestType type, Address destination, unsigned int sentSize,
+                                unsigned char *sentPayload, unsigned long timeLimitMS,
+                                RequestCallback callback)
 {
     PQ9Frame sentFrame;
-    unsigned char serviceNum;
 
+    // Checked before the copy: the payload of the frame has MAX_PAYLOAD_SIZE bytes
     if (sentSize > MAX_PAYLOAD_SIZE)
     {
 #ifdef COMMUNICATION_DEBUG
-        Console::log("SendFrame(): size of payload is too big: %d bytes", sentSize);
+        Console::log("RequestReplyAsync(): size of payload is too big: %d bytes", sentSize);
 #endif
+        return INVALID_REQUEST_HANDLE;
     }
 
-    sentFrame.setSource(OBC);
     sentFrame.setDestination(destination);
     sentFrame.setPayloadSize(sentSize);
-    serviceNum = sentPayload[0];
 
     // Copy payload to sentframe
-    for (int i = 0; i < sentSize; i++)
+    memcpy(sentFrame.getPayload(), sentPayload, sentSize);
+
+    return RequestFrameAsync(type, sentFrame, timeLimitMS, callback);
+}
+
+
+/**
+ *
+ *  Sleep in low-power mode
+ *  Please read Communication.h
+ *
+ */
+void CommunicationSleep(unsigned long sleepMS)
+{
+    if (sleepMS == 0)
     {
-        sentFrame.getPayload()[i] = sentPayload[i];
+        return;
     }
 
-    // Sent the frame
-    TransmitWithTimeLimit(sentFrame, timeLimitMS);
+    MAP_Interrupt_disableMaster();
+    sleepRemainingMS = sleepMS;
+    StartTick();
+    MAP_Interrupt_enableMaster();
 
-    // Check the reply
-    if ((cmdReceivedFlag == true)
-        && (receivedFrame->getPayloadSize() > 1)
-        && (receivedFrame->getSource() == destination)
-        && (receivedFrame->getPayload()[0] == serviceNum)
-        && (receivedFrame->getPayload()[1] == SERVICE_RESPONSE_REPLY))
+    // The received frames are still processed while sleeping
+    while (sleepRemainingMS > 0)
     {
-        // Kick internal watchdog (time window: 178s)
-        reset.kickInternalWatchDog();
+        commEvent = false;
+        CommunicationPoll();
+        if (sleepRemainingMS > 0)
+        {
+            SleepUntilEvent();
+        }
+    }
+}
+
+
+/**
+ *
+ *  Set the retry policy of a request type
+ *  Please read Communication.h
+ *
+ */
+void SetRetryPolicy(RequestType type, RetryPolicy policy)
+{
+    retryPolicies[type] = policy;
+}
 
-        *receivedPayload = receivedFrame->getPayload();
-        *receivedSize = receivedFrame->getPayloadSize();
-        return SERVICE_RESPONSE_REPLY;
+
+/**
+ *
+ *  Start the time budget of a StateMachine() tick
+ *  Please read Communication.h
+ *
+ */
+void CommunicationStartTick(unsigned long budgetMS)
+{
+    bool wasDisabled = EnterCritical();
+
+    // The 1ms tick keeps running until CommunicationEndTick(), so the budget also counts
+    // the time spent between the requests (FRAM, decisions, ...)
+    if (!tickClock)
+    {
+        tickClock = true;
+        StartTick();
     }
-    else if (cmdReceivedFlag == false)
-        return SERVICE_NO_RESPONSE;
-    else
+    tickStartMS = commTimeMS;
+    tickBudgetMS = budgetMS;
+    ExitCritical(wasDisabled);
+}
+
+
+/**
+ *
+ *  End the time budget of a StateMachine() tick
+ *  Please read Communication.h
+ *
+ */
+void CommunicationEndTick()
+{
+    if (tickClock)
+    {
+        tickClock = false;
+        ReleaseTick();
+    }
+}
+
+
+/**
+ *
+ *  Keep the 1ms tick running for another task
+ *  Please read Communication.h
+ *
+ */
+void CommunicationHoldClock()
+{
+    bool wasDisabled = EnterCritical();
+
+    StartTick();
+    ExitCritical(wasDisabled);
+}
+
+void CommunicationReleaseClock()
+{
+    ReleaseTick();
+}
+
+unsigned long CommunicationTimeMS()
+{
+    return commTimeMS;
+}
+
+
+/**
+ *
+ *  Backoff before a retry: it's doubled every retry
+ *
+ */
+unsigned long RetryBackoff(RequestType type, int retry)
+{
+    return retryPolicies[type].backoffMS << (retry - 1);
+}
+
+
+/**
+ *
+ *  Check whether a failed request can be retried
+ *
+ *  Parameters:
+ *      RequestType type                Type of the request
+ *      int retry                       Number of the retry (1 is the first retry)
+ *      char status                     Result of the previous attempt
+ *      Address destination             Address of the target board
+ *      unsigned char serviceNum        Service number of the request
+ *      unsigned long timeLimitMS       Worst-case time limit of the request
+ *  Returns:
+ *      RetryAllowed()                  true if the policy allows the retry and the backoff plus
+ *                                      the time limit fit in the budget of this tick
+ *
+ */
+bool RetryAllowed(RequestType type, int retry, char status, Address destination, unsigned char serviceNum,
+                  unsigned long timeLimitMS)
+{
+    RetryPolicy &policy = retryPolicies[type];
+
+    if ((status == SERVICE_RESPONSE_REPLY) || (retry > policy.retries))
+    {
+        return false;
+    }
+
+    // Without a reply we don't know whether the command has been executed
+    if ((status == SERVICE_NO_RESPONSE) && !policy.idempotent)
+    {
+        return false;
+    }
+
+    if (commTimeMS - tickStartMS + RetryBackoff(type, retry)
+            + TimeoutGetLimit(destination, serviceNum, timeLimitMS) > tickBudgetMS)
+    {
+#ifdef COMMUNICATION_DEBUG
+        Console::log("RetryAllowed(): no time left in this tick for destination %d", destination);
+#endif
+        return false;
+    }
+    return true;
+}
+
+
+/**
+ *
+ *  Send a frame over the bus and get the reply, retry according to the policy
+ *  Please read Communication.h
+ *
+ */
+char RequestReplyRetry(RequestType type, Address destination, unsigned int sentSize, unsigned char *sentPayload,
+                       unsigned int *receivedSize, unsigned char *receivedPayload,
+                       unsigned long timeLimitMS)
+{
+    unsigned int bufferSize = *receivedSize;
+    char status;
+
+    status = RequestReply(type, destination, sentSize, sentPayload, receivedSize, receivedPayload, timeLimitMS);
+
+    for (int retry = 1; RetryAllowed(type, retry, status, destination, sentPayload[0], timeLimitMS); retry++)
+    {
+        CommunicationSleep(RetryBackoff(type, retry));
+        retryCount++;
+        *receivedSize = bufferSize;
+        status = RequestReply(type, destination, sentSize, sentPayload, receivedSize, receivedPayload, timeLimitMS);
+    }
+    return status;
+}
+
+
+/**
+ *
+ *  Counters of retries and requests without reply since boot
+ *  Please read Communication.h
+ *
+ */
+unsigned long CommunicationRetryCount()
+{
+    return retryCount;
+}
+
+unsigned long CommunicationTimeoutCount()
+{
+    return timeoutCount;
+}
+
+unsigned long CommunicationDroppedCount()
+{
+    return droppedCount;
+}
+
+unsigned long CommunicationRxOverflowCount()
+{
+    return rxOverflowCount;
+}
+
+
+/**
+ *
+ *  Prepare a service request (e.g. ping or housekeeping) directly in the frame
+ *
+ */
+void PrepareServiceRequest(PQ9Frame &sentFrame, Address destination, unsigned char serviceNum)
+{
+    sentFrame.setDestination(destination);
+    sentFrame.setPayloadSize(2);
+    sentFrame.getPayload()[0] = serviceNum;
+    sentFrame.getPayload()[1] = SERVICE_RESPONSE_REQUEST;
+}
+
+
+/**
+ *
+ *  Get the status of a request without waiting
+ *  Please read Communication.h
+ *
+ */
+char RequestStatus(RequestHandle handle)
+{
+    CommRequest *request = FindRequest(handle);
+
+    if (request == 0)
+    {
+        return SERVICE_RESPONSE_ERROR;
+    }
+    return request->status;
+}
+
+
+/**
+ *
+ *  Sleep in low-power mode until a request is completed
+ *  Please read Communication.h
+ *
+ */
+char RequestWait(RequestHandle handle)
+{
+    CommRequest *request;
+
+    for (;;)
+    {
+        commEvent = false;
+        CommunicationPoll();
+        if (RequestStatus(handle) != SERVICE_PENDING)
+        {
+            break;
+        }
+        SleepUntilEvent();
+    }
+
+    request = FindRequest(handle);
+    if (request == 0)
+    {
+        return SERVICE_RESPONSE_ERROR;
+    }
+
+#ifdef COMMUNICATION_DEBUG
+    Console::log("RequestWait(): response time: %d ms", commTimeMS - request->startMS);
+#endif
+    return request->status;
+}
+
+
+/**
+ *
+ *  Send a frame over the bus and get the reply
+ *  Please read Communication.h
+ *
+ */
+char RequestReply(RequestType type, Address destination, unsigned int sentSize, unsigned char *sentPayload,
+                  unsigned int *receivedSize, unsigned char *receivedPayload,
+                  unsigned long timeLimitMS)
+{
+    RequestHandle handle;
+    CommRequest *request;
+    char status;
+
+    handle = RequestReplyAsync(type, destination, sentSize, sentPayload, timeLimitMS, 0);
+    if (handle == INVALID_REQUEST_HANDLE)
+    {
         return SERVICE_RESPONSE_ERROR;
+    }
+
+    // Frames are only processed by CommunicationPoll(), so the reply can't be there yet
+    request = FindRequest(handle);
+    request->replyBuffer = receivedPayload;
+    request->replyMaxSize = *receivedSize;
+
+    // The CPU sleeps until the reply arrives or the time limit expires
+    status = RequestWait(handle);
+    *receivedSize = (status == SERVICE_RESPONSE_REPLY) ? request->replySize : 0;
+    return status;
 }
 
 
@@ -136,43 +1025,142 @@ char RequestReply(Address destination, unsigned char sentSize, unsigned char *se
  */
 char PingModule(Address destination)
 {
-    unsigned char sentPayload[2];
-    unsigned char receivedSize;
-    unsigned char *receivedPayload;
+    PQ9Frame sentFrame;
+    char status;
 
-    sentPayload[0] = PING_SERVICE;
-    sentPayload[1] = SERVICE_RESPONSE_REQUEST;
+    PrepareServiceRequest(sentFrame, destination, PING_SERVICE);
 
     // The time limit is set to 10ms
-    return RequestReply(destination, 2, sentPayload, &receivedSize, &receivedPayload, 10);
+    status = RequestWait(RequestFrameAsync(PING_REQUEST, sentFrame, 10, 0));
+
+    for (int retry = 1; RetryAllowed(PING_REQUEST, retry, status, destination, PING_SERVICE, 10); retry++)
+    {
+        CommunicationSleep(RetryBackoff(PING_REQUEST, retry));
+        retryCount++;
+        status = RequestWait(RequestFrameAsync(PING_REQUEST, sentFrame, 10, 0));
+    }
+    return status;
+}
+
+
+/**
+ *
+ *  Completion of a housekeeping request in a telemetry sweep.
+ *  The reply is copied here: the slot of the receive ring is reused later.
+ *  Then the callback of the slot can use the telemetry at once.
+ *
+ */
+void SweepCompleted(RequestHandle handle, char status, DataFrame *reply)
+{
+    // Match on the destination: the reply can arrive before RequestReplyAsync() returns the handle
+    Address destination = FindRequest(handle)->destination;
+
+    for (int i = 0; i < sweepSize; i++)
+    {
+        if (sweepSlots[i].destination != destination)
+        {
+            continue;
+        }
+
+        // Copy the received telemetry to the container (never more than the container size)
+        if (status == SERVICE_RESPONSE_REPLY)
+        {
+            int size = reply->getPayloadSize() - 2;
+            if (size > sweepSlots[i].size)
+            {
+                size = sweepSlots[i].size;
+            }
+            sweepSlots[i].dirtyLines |= DirtyLinesCopy(sweepSlots[i].array, reply->getPayload() + 2, size);
+        }
+        sweepSlots[i].response = status;
+
+        if ((status == SERVICE_RESPONSE_REPLY) && sweepSlots[i].received)
+        {
+            sweepSlots[i].received(sweepSlots[i]);
+        }
+        return;
+    }
+}
+
+
+/**
+ *
+ *  Send the housekeeping requests of the sweep slots which are SERVICE_PENDING and
+ *  wait for the slowest module, the replies are copied by SweepCompleted()
+ *
+ */
+void SweepRound(TelemetrySweepSlot *slots, int count)
+{
+    PQ9Frame sentFrame;
+
+    // Send all requests back to back, the time limit of each one is set to 100ms
+    for (int i = 0; i < count; i++)
+    {
+        slots[i].handle = INVALID_REQUEST_HANDLE;
+        if (slots[i].response != SERVICE_PENDING)
+        {
+            continue;
+        }
+
+        PrepareServiceRequest(sentFrame, slots[i].destination, HOUSEKEEPING_SERVICE);
+        slots[i].handle = RequestFrameAsync(HOUSEKEEPING_REQUEST, sentFrame, 100, SweepCompleted);
+        if (slots[i].handle == INVALID_REQUEST_HANDLE)
+        {
+            slots[i].response = SERVICE_RESPONSE_ERROR;
+        }
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (slots[i].handle != INVALID_REQUEST_HANDLE)
+        {
+            RequestWait(slots[i].handle);
+        }
+    }
 }
 
 
 /**
  *
- *  Request telemetry from a specific module
+ *  Request telemetry from several modules at the same time
  *  Please read Communication.h
  *
  */
-char RequestTelemetry(Address destination, TelemetryContainer *container)
+void RequestTelemetrySweep(TelemetrySweepSlot *slots, int count)
 {
-    unsigned char sentPayload[2];
-    unsigned char receivedSize;
-    unsigned char *receivedPayload;
-    char ret;
+    int failed;
 
-    sentPayload[0] = HOUSEKEEPING_SERVICE;
-    sentPayload[1] = SERVICE_RESPONSE_REQUEST;
+    for (int i = 0; i < count; i++)
+    {
+        slots[i].response = SERVICE_PENDING;
+    }
+    sweepSlots = slots;
+    sweepSize = count;
 
-    // The time limit is set to 100ms
-    ret = RequestReply(destination, 2, sentPayload, &receivedSize, &receivedPayload, 100);
+    SweepRound(slots, count);
 
-    // Copy the received telemetry to the container
-    if (ret == SERVICE_RESPONSE_REPLY)
+    // Retry the modules which failed, all together
+    for (int retry = 1; ; retry++)
     {
-        for (int i = 0; i < receivedSize - 2; i++)
-            container->getArray()[i] = receivedPayload[i + 2];
+        failed = 0;
+        for (int i = 0; i < count; i++)
+        {
+            if (RetryAllowed(HOUSEKEEPING_REQUEST, retry, slots[i].response, slots[i].destination,
+                             HOUSEKEEPING_SERVICE, 100))
+            {
+                slots[i].response = SERVICE_PENDING;
+                failed++;
+            }
+        }
+        if (failed == 0)
+        {
+            break;
+        }
+
+        CommunicationSleep(RetryBackoff(HOUSEKEEPING_REQUEST, retry));
+        retryCount += failed;
+        SweepRound(slots, count);
     }
 
-    return ret;
+    sweepSize = 0;
 }
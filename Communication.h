@@ -9,56 +9,330 @@
 
 #include "TelemetryContainer.h"
 #include "DataFrame.h"
+#include "PQ9Frame.h"
 
 #define SERVICE_RESPONSE_ERROR      0
 #define SERVICE_RESPONSE_REQUEST    1
 #define SERVICE_RESPONSE_REPLY      2
 #define SERVICE_NO_RESPONSE         3
+#define SERVICE_PENDING             4   // Only used locally, never sent over the bus
+
+#define INVALID_REQUEST_HANDLE      -1
+#define COMMUNICATION_MAX_REQUESTS  8   // Maximum number of pending requests
+#define COMMUNICATION_DEFAULT_BUDGET_MS 700 // Bus time of a StateMachine() tick (period: 1000ms)
+#define RX_RING_SIZE                8   // Received frames waiting for the task (power of 2)
 
 // Address number for pq9bus
 typedef enum Address {OBC = 1, EPS = 2, ADB = 3, COMMS = 4,
     ADCS = 5, PROP = 6, DEBUG = 7, EGSE = 8, HPI = 100} Address;
 
+// Types of request, each one has its own retry policy
+typedef enum RequestType {PING_REQUEST, HOUSEKEEPING_REQUEST, POWER_REQUEST, DEPLOY_REQUEST} RequestType;
+#define REQUEST_TYPES               4
+
+// Priority of the requests on the bus (the first one is the highest), given by the type:
+// power commands are critical, then deployment, housekeeping and ping
+typedef enum RequestPriority {CRITICAL_PRIORITY, DEPLOY_PRIORITY, HOUSEKEEPING_PRIORITY, PING_PRIORITY} RequestPriority;
+
+typedef struct RetryPolicy
+{
+    unsigned char retries;          // Number of retries after the first attempt
+    unsigned long backoffMS;        // Wait before the first retry, doubled every next retry
+    bool idempotent;                // If false, a request without reply is never retried
+                                    // (only a request which got an error reply)
+} RetryPolicy;
+
+// Handle of a request started by RequestReplyAsync()
+typedef int RequestHandle;
+
+// Called as soon as the reply of a module in a telemetry sweep is copied, see RequestTelemetrySweep()
+struct TelemetrySweepSlot;
+typedef void (*SweepCallback)(struct TelemetrySweepSlot &slot);
+
+// One module in a telemetry sweep, see RequestTelemetrySweep()
+typedef struct TelemetrySweepSlot
+{
+    Address destination;
+    unsigned char *array;           // Telemetry array of the container, see TelemetrySweepSlotOf()
+    int size;
+    char response;                  // Filled by RequestTelemetrySweep()
+    RequestHandle handle;           // Used internally
+    unsigned long dirtyLines;       // Lines of the container changed by the replies (ORed),
+                                    // see DirtyLines.h
+    SweepCallback received;         // Called when the module replied (can be 0)
+} TelemetrySweepSlot;
+
 /**
  *
- *  Interrupt service routine when OBC gets a reply
+ *  Callback invoked when a request is completed (reply, error or timeout).
+ *  It runs in the task, from CommunicationPoll() (called by RequestWait() and
+ *  CommunicationSleep()), so it may use the bus.
+ *
+ *  Parameters:
+ *      RequestHandle handle            Handle returned by RequestReplyAsync()
+ *      char status                     SERVICE_RESPONSE_REPLY or
+ *                                      SERVICE_RESPONSE_ERROR or
+ *                                      SERVICE_NO_RESPONSE
+ *      DataFrame *reply                The reply (0 if status is SERVICE_NO_RESPONSE)
+ *
+ */
+typedef void (*RequestCallback)(RequestHandle handle, char status, DataFrame *reply);
+
+/**
+ *
+ *  Initialize the request engine: it registers the Timer32 interrupt used
+ *  for the time limit of the requests. Call it once in main.cpp
+ *
+ */
+void CommunicationInit();
+
+/**
+ *
+ *  Interrupt service routine when OBC gets a frame (a reply or a request)
  *  It's registered by pq9bus.setReceiveHandler() in main.cpp
  *
  *  Parameters:
- *      DataFrame &newFrame         Reference of the reply
- *  External variables used:
- *      bool cmdReceivedFlag        It indicates whether OBC gets a reply
- *      PQ9Frame *receivedFrame     Address of the reply
+ *      DataFrame &newFrame         Reference of the frame
+ *  It only copies the frame in the receive ring (the frame is dropped if the ring is full)
+ *  and notifies communicationTask (defined in main.cpp), the frame is processed by
+ *  CommunicationPoll()
  *
  */
 void receivedCommand(DataFrame &newFrame);
 
+/**
+ *
+ *  Process the received frames and complete the requests (reply, error or timeout),
+ *  then send the queued requests. Called by RequestWait(), CommunicationSleep() and
+ *  communicationTask, so the callbacks don't wait for StateMachine().
+ *
+ *  The received frames are routed by the type in the second byte of the payload:
+ *      SERVICE_RESPONSE_REQUEST        Passed to the request handler, see CommunicationSetRequestHandler()
+ *      other                           Completes the pending request to the source with the
+ *                                      same service number (dropped if there is none)
+ *
+ */
+void CommunicationPoll();
+
+/**
+ *
+ *  Set the handler of the requests received from the other modules (e.g. EGSE or
+ *  ground commands forwarded by COMMS). It's called by CommunicationPoll(), not by
+ *  the interrupt, and it must copy the frame: the slot of the ring is reused.
+ *  On the target it's CommandHandler::received() of DelfiPQcore, which answers
+ *  with the services of main.cpp: the service interface stays inside DelfiPQcore.
+ *  Without a handler the requests are dropped.
+ *
+ *  Parameters:
+ *      void (*handler)(DataFrame &request)     Function receiving the request
+ *
+ */
+void CommunicationSetRequestHandler(void (*handler)(DataFrame &request));
+
+/**
+ *
+ *   Send a frame prepared by the caller without waiting for the reply.
+ *   The frame is passed by reference to the bus driver, nothing is copied.
+ *
+ *   The frame waits in a priority queue while a request with a higher priority is
+ *   pending (sent or queued), or an older request with the same priority is queued.
+ *   Then only the payload is copied (at most 16 bytes). A queued request whose time
+ *   limit expires before it is sent is dropped (SERVICE_NO_RESPONSE).
+ *
+ *   Parameters:
+ *      RequestType type                Type of the request, it gives the priority
+ *      PQ9Frame &sentFrame             Frame with destination, payload size and payload set
+ *                                      (the source is set to OBC here)
+ *      unsigned long timeLimitMS       Worst-case time limit. The actual time limit is estimated
+ *                                      from the previous replies of the module (TimeoutEstimator.h).
+ *                                      If it expires and OBC doesn't get a reply,
+ *                                      the request is completed with SERVICE_NO_RESPONSE
+ *      RequestCallback callback        Called when the request is completed (can be 0)
+ *   Returns:
+ *      RequestFrameAsync()             Handle of the request or
+ *                                      INVALID_REQUEST_HANDLE if a request to the same
+ *                                      destination and service is pending or all slots are in use
+ *
+ */
+RequestHandle RequestFrameAsync(RequestType type, PQ9Frame &sentFrame, unsigned long timeLimitMS,
+                                RequestCallback callback);
+
+/**
+ *
+ *   Send a frame over the bus without waiting for the reply
+ *   (the payload is copied in a frame, then RequestFrameAsync() is used)
+ *
+ *   Parameters:
+ *      RequestType type                Type of the request, it gives the priority
+ *      Address destination             Address of the target board except OBC
+ *      unsigned int sentSize           Size of the payload in the sent frame (at most 255 bytes)
+ *      unsigned char *sentPayload      Payload in the sent frame
+ *      unsigned long timeLimitMS       Worst-case time limit. The actual time limit is estimated
+ *                                      from the previous replies of the module (TimeoutEstimator.h).
+ *                                      If it expires and OBC doesn't get a reply,
+ *                                      the request is completed with SERVICE_NO_RESPONSE
+ *      RequestCallback callback        Called when the request is completed (can be 0)
+ *   Returns:
+ *      RequestReplyAsync()             Handle of the request or
+ *                                      INVALID_REQUEST_HANDLE if the payload is too big, or a request
+ *                                      to the same destination and service is pending or all slots are in use
+ *
+ */
+RequestHandle RequestReplyAsync(RequestType type, Address destination, unsigned int sentSize,
+                                unsigned char *sentPayload, unsigned long timeLimitMS,
+                                RequestCallback callback);
+
+/**
+ *
+ *   Get the status of a request without waiting
+ *
+ *   Parameters:
+ *      RequestHandle handle            Handle returned by RequestReplyAsync()
+ *   Returns:
+ *      RequestStatus()                 SERVICE_PENDING or
+ *                                      SERVICE_RESPONSE_REPLY or
+ *                                      SERVICE_RESPONSE_ERROR or
+ *                                      SERVICE_NO_RESPONSE
+ *
+ */
+char RequestStatus(RequestHandle handle);
+
+/**
+ *
+ *   Sleep in low-power mode until a request is completed
+ *
+ *   Parameters:
+ *      RequestHandle handle            Handle returned by RequestReplyAsync()
+ *   Returns:
+ *      RequestWait()                   SERVICE_RESPONSE_REPLY or
+ *                                      SERVICE_RESPONSE_ERROR or
+ *                                      SERVICE_NO_RESPONSE
+ *   The reply itself is given to the callback of the request (or copied by RequestReply()).
+ *
+ */
+char RequestWait(RequestHandle handle);
+
 /**
  *
  *   Send a frame over the bus and get the reply
  *
  *   Parameters:
+ *      RequestType type                Type of the request, it gives the priority
  *      Address destination             Address of the target board except OBC
- *      unsigned char sentSize          Size of the payload in the sent frame
+ *      unsigned int sentSize           Size of the payload in the sent frame (at most 255 bytes)
  *      unsigned char *sentPayload      Payload in the sent frame
- *      unsigned long timeLimitMS       If timeLimitMS expires and OBC doesn't get a reply,
+ *      unsigned long timeLimitMS       Worst-case time limit (see RequestFrameAsync()).
+ *                                      If it expires and OBC doesn't get a reply,
  *                                      return SERVICE_NO_RESPONSE
+ *      unsigned int *receivedSize      Size of the buffer for the received payload
+ *      unsigned char *receivedPayload  Buffer for the received payload (the reply is copied once,
+ *                                      straight from the receive ring)
  *   Returns:
  *      RequestReply()                  SERVICE_RESPONSE_REPLY or
- *                                      SERVICE_RESPONSE_ERROR or
+ *                                      SERVICE_RESPONSE_ERROR (also if the payload is too big) or
  *                                      SERVICE_NO_RESPONSE
- *      unsigned char *receivedSize     Size of the payload in the received frame
- *      unsigned char **receivedPayload Address for the pointer for the received payload.
- *                                      RequestReply() will change this pointer, so it points to the payload.
+ *      unsigned int *receivedSize      Size of the payload in the received frame, never more than
+ *                                      the size of the buffer (0 without reply)
+ *      unsigned char *receivedPayload  The received payload
  *
  */
-char RequestReply(Address destination, unsigned char sentSize, unsigned char *sentPayload,
-                  unsigned char *receivedSize, unsigned char **receivedPayload,
+char RequestReply(RequestType type, Address destination, unsigned int sentSize, unsigned char *sentPayload,
+                  unsigned int *receivedSize, unsigned char *receivedPayload,
                   unsigned long timeLimitMS);
 
 /**
  *
- *   Ping a module
+ *   Send a frame over the bus and get the reply, retry according to the policy of the
+ *   request type. A retry is only sent if its backoff and time limit fit in the time
+ *   budget of the current tick (see CommunicationStartTick()).
+ *
+ *   Parameters:
+ *      RequestType type                Type of the request, it selects the retry policy
+ *      Other parameters and returns    Same as RequestReply()
+ *
+ */
+char RequestReplyRetry(RequestType type, Address destination, unsigned int sentSize, unsigned char *sentPayload,
+                       unsigned int *receivedSize, unsigned char *receivedPayload,
+                       unsigned long timeLimitMS);
+
+/**
+ *
+ *   Set the retry policy of a request type
+ *
+ *   Parameters:
+ *      RequestType type                Type of the request
+ *      RetryPolicy policy              Number of retries, backoff and idempotency
+ *
+ */
+void SetRetryPolicy(RequestType type, RetryPolicy policy);
+
+/**
+ *
+ *   Start the time budget of a StateMachine() tick. The time is counted from here by the
+ *   1ms tick, which keeps running until CommunicationEndTick(), and no retry is sent once
+ *   the budget is used up.
+ *
+ *   Parameters:
+ *      unsigned long budgetMS          Time budget in ms
+ *
+ */
+void CommunicationStartTick(unsigned long budgetMS);
+
+/**
+ *
+ *   End the time budget of a StateMachine() tick: the 1ms tick stops when no request
+ *   is pending, so the CPU isn't woken up every ms until the next tick
+ *
+ */
+void CommunicationEndTick();
+
+/**
+ *
+ *   Keep the 1ms tick running for another task which needs the time (e.g. the time
+ *   budget of SDCardAccess()), until CommunicationReleaseClock()
+ *
+ */
+void CommunicationHoldClock();
+void CommunicationReleaseClock();
+
+/**
+ *
+ *   Returns:
+ *      CommunicationTimeMS()           Time in ms, it only counts while the 1ms tick runs
+ *                                      (see CommunicationHoldClock())
+ *
+ */
+unsigned long CommunicationTimeMS();
+
+/**
+ *
+ *   Sleep in low-power mode (used for the backoff)
+ *
+ *   Parameters:
+ *      unsigned long sleepMS           Time to sleep in ms
+ *
+ */
+void CommunicationSleep(unsigned long sleepMS);
+
+/**
+ *
+ *   Counters since boot
+ *
+ *   Returns:
+ *      CommunicationRetryCount()       Number of retries sent
+ *      CommunicationTimeoutCount()     Number of requests without reply
+ *      CommunicationDroppedCount()     Number of queued requests dropped before they were sent
+ *      CommunicationRxOverflowCount()  Number of received frames lost because the ring was full
+ *
+ */
+unsigned long CommunicationRetryCount();
+unsigned long CommunicationTimeoutCount();
+unsigned long CommunicationDroppedCount();
+unsigned long CommunicationRxOverflowCount();
+
+/**
+ *
+ *   Ping a module (retried with the PING_REQUEST policy)
  *
  *   Parameters:
  *      Address destination             Address of the target board except OBC
@@ -70,6 +344,50 @@ char RequestReply(Address destination, unsigned char sentSize, unsigned char *se
  */
 char PingModule(Address destination);
 
+/**
+ *
+ *  Slot of a telemetry sweep for a container: its array and its size.
+ *
+ *   Parameters:
+ *      Address destination             Address of the target board except OBC
+ *      Container &container            The container (e.g. EPSTelemetryContainer)
+ *   Returns:
+ *      TelemetrySweepSlotOf()          The slot
+ *
+ */
+template <class Container>
+inline TelemetrySweepSlot TelemetrySweepSlotOf(Address destination, Container &container)
+{
+    TelemetrySweepSlot slot = {destination, container.Container::getArray(), container.Container::size(),
+                               SERVICE_NO_RESPONSE, INVALID_REQUEST_HANDLE, 0, 0};
+    return slot;
+}
+
+/**
+ *
+ *  Request telemetry from several modules at the same time.
+ *  All housekeeping requests are sent back to back and the replies are matched
+ *  by their source address, so the sweep takes as long as the slowest module.
+ *  The modules which failed are retried together (HOUSEKEEPING_REQUEST policy).
+ *
+ *  The callback of a slot runs as soon as its reply is copied, while the other
+ *  modules are still pending, so a decision on that telemetry (e.g. a power command)
+ *  doesn't wait for the whole sweep. It may send requests with RequestReplyAsync(),
+ *  but must not wait for them.
+ *
+ *   Parameters:
+ *      TelemetrySweepSlot *slots       Destination and container of every module
+ *                                      (see TelemetrySweepSlotOf()), with an optional callback
+ *      int count                       Number of slots (at most COMMUNICATION_MAX_REQUESTS)
+ *   Returns:
+ *      slots[i].response               SERVICE_RESPONSE_REPLY or
+ *                                      SERVICE_RESPONSE_ERROR or
+ *                                      SERVICE_NO_RESPONSE
+ *      slots[i].array                  The retrieved telemetry will be copied to the container
+ *
+ */
+void RequestTelemetrySweep(TelemetrySweepSlot *slots, int count);
+
 /**
  *
  *  Request telemetry from a specific module
@@ -80,9 +398,17 @@ char PingModule(Address destination);
  *      RequestTelemetry                SERVICE_RESPONSE_REPLY or
  *                                      SERVICE_RESPONSE_ERROR or
  *                                      SERVICE_NO_RESPONSE
- *      TelemetryContainer *container   The retrieved telemetry will be copied to the container
+ *      Container *container            The retrieved telemetry will be copied to the container
  *
  */
-char RequestTelemetry(Address destination, TelemetryContainer *container);
+template <class Container>
+inline char RequestTelemetry(Address destination, Container *container)
+{
+    TelemetrySweepSlot slot = TelemetrySweepSlotOf(destination, *container);
+
+    // Same path as a sweep: the reply is copied once, straight from the receive ring
+    RequestTelemetrySweep(&slot, 1);
+    return slot.response;
+}
 
 #endif /* COMMUNICATION_H_ */
@@ -20,8 +20,8 @@ bool DeployAntenna() {
     char request = 0x01;
 
     //char to store received command
-    unsigned char* Reply;
-    unsigned char ReplySize;
+    unsigned char Reply[7];
+    unsigned int ReplySize = sizeof(Reply);
     unsigned char Payload[7];
 
     //Set data structure according to data structure defined in xml file
@@ -34,7 +34,7 @@ bool DeployAntenna() {
     Payload[6] = 0x11; //todo set this value
 
     //Send to ADB
-    if (RequestReply(ADB, 6, Payload, &ReplySize, &Reply, 500) == SERVICE_RESPONSE_REPLY)
+    if (RequestReplyRetry(DEPLOY_REQUEST, ADB, 6, Payload, &ReplySize, Reply, 500) == SERVICE_RESPONSE_REPLY)
     {
         done = true;
     }
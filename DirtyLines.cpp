@@ -0,0 +1,51 @@
+/*
+ *  DirtyLines.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "DirtyLines.h"
+#include <string.h>
+
+/**
+ *
+ *  Mask of the lines covering a range of bytes
+ *  Please read DirtyLines.h
+ *
+ */
+unsigned long DirtyLinesOf(int first, int count)
+{
+    int firstLine = first / DIRTY_LINE_SIZE;
+    int lastLine = (first + count - 1) / DIRTY_LINE_SIZE;
+    unsigned long mask = 0;
+
+    for (int line = firstLine; (line <= lastLine) && (line < 32); line++)
+    {
+        mask |= 1UL << line;
+    }
+    return mask;
+}
+
+/**
+ *
+ *  Copy an array and find the lines which changed
+ *  Please read DirtyLines.h
+ *
+ */
+unsigned long DirtyLinesCopy(unsigned char *destination, unsigned char *source, int size)
+{
+    unsigned long mask = 0;
+
+    for (int start = 0, line = 0; start < size; start += DIRTY_LINE_SIZE, line++)
+    {
+        int length = (size - start < DIRTY_LINE_SIZE) ? (size - start) : DIRTY_LINE_SIZE;
+
+        if (memcmp(&destination[start], &source[start], length) != 0)
+        {
+            memcpy(&destination[start], &source[start], length);
+            mask |= 1UL << line;
+        }
+    }
+    return mask;
+}
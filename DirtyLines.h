@@ -0,0 +1,45 @@
+/*
+ *  DirtyLines.h
+ *
+ *  Tracks which parts of a telemetry array changed since it was saved in FRAM.
+ *  The array is divided in lines of DIRTY_LINE_SIZE bytes, bit n of the mask
+ *  is set when line n changed (at most 32 lines, so 512 bytes).
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef DIRTYLINES_H_
+#define DIRTYLINES_H_
+
+#define DIRTY_LINE_SIZE             16
+#define DIRTY_ALL_LINES             0xFFFFFFFF
+
+/**
+ *
+ *  Mask of the lines covering a range of bytes
+ *
+ *  Parameters:
+ *      int first                       Index of the first byte
+ *      int count                       Number of bytes (more than 0)
+ *  Returns:
+ *      DirtyLinesOf()                  Mask of the lines
+ *
+ */
+unsigned long DirtyLinesOf(int first, int count);
+
+/**
+ *
+ *  Copy an array and find the lines which changed
+ *
+ *  Parameters:
+ *      unsigned char *destination      The array to update
+ *      unsigned char *source           The new values
+ *      int size                        Number of bytes to copy
+ *  Returns:
+ *      DirtyLinesCopy()                Mask of the lines which are different
+ *
+ */
+unsigned long DirtyLinesCopy(unsigned char *destination, unsigned char *source, int size);
+
+#endif /* DIRTYLINES_H_ */
@@ -7,771 +7,584 @@
 
 #include <EPSTelemetryContainer.h>
 
-int EPSTelemetryContainer::size()
-{
-    return EPS_CONTAINER_SIZE;
-}
-
-unsigned char* EPSTelemetryContainer::getArray()
-{
-    return &telemetry[0];
-}
-
 unsigned long EPSTelemetryContainer::getUpTime()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[0];
-    ((unsigned char *)&ulong)[2] = telemetry[1];
-    ((unsigned char *)&ulong)[1] = telemetry[2];
-    ((unsigned char *)&ulong)[0] = telemetry[3];
-    return ulong;
+    return UpTimeField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setUpTime(unsigned long ulong)
 {
-    *((unsigned long *)&(telemetry[0])) = ulong;
-    telemetry[0] = ((unsigned char *)&ulong)[3];
-    telemetry[1] = ((unsigned char *)&ulong)[2];
-    telemetry[2] = ((unsigned char *)&ulong)[1];
-    telemetry[3] = ((unsigned char *)&ulong)[0];
+    UpTimeField::set(telemetry, ulong);
 }
 
 bool EPSTelemetryContainer::getSPYpStatus()
 {
-    return ((telemetry[9] & 0x01) != 0);
+    return SPYpStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPYpStatus(bool bval)
 {
-    telemetry[9] &= (~0x01);
-    telemetry[9] |= bval ? 0x01 : 0x00;
+    SPYpStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getSPYmStatus()
 {
-    return ((telemetry[9] & 0x02) != 0);
+    return SPYmStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPYmStatus(bool bval)
 {
-    telemetry[9] &= (~0x02);
-    telemetry[9] |= bval ? 0x02 : 0x00;
+    SPYmStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getSPXpStatus()
 {
-    return ((telemetry[9] & 0x04) != 0);
+    return SPXpStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPXpStatus(bool bval)
 {
-    telemetry[9] &= (~0x04);
-    telemetry[9] |= bval ? 0x04 : 0x00;
+    SPXpStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getSPXmStatus()
 {
-    return ((telemetry[9] & 0x08) != 0);
+    return SPXmStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPXmStatus(bool bval)
 {
-    telemetry[9] &= (~0x08);
-    telemetry[9] |= bval ? 0x08 : 0x00;
+    SPXmStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getB1Status()
 {
-    return ((telemetry[8] & 0x10) != 0);
+    return B1StatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB1Status(bool bval)
 {
-    telemetry[8] &= (~0x10);
-    telemetry[8] |= bval ? 0x10 : 0x00;
+    B1StatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getB2Status()
 {
-    return ((telemetry[8] & 0x20) != 0);
+    return B2StatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB2Status(bool bval)
 {
-    telemetry[8] &= (~0x20);
-    telemetry[8] |= bval ? 0x20 : 0x00;
+    B2StatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getB3Status()
 {
-    return ((telemetry[8] & 0x40) != 0);
+    return B3StatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB3Status(bool bval)
 {
-    telemetry[8] &= (~0x40);
-    telemetry[8] |= bval ? 0x40 : 0x00;
+    B3StatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getB4Status()
 {
-    return ((telemetry[8] & 0x80) != 0);
+    return B4StatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB4Status(bool bval)
 {
-    telemetry[8] &= (~0x80);
-    telemetry[8] |= bval ? 0x80 : 0x00;
+    B4StatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getIntBStatus()
 {
-    return ((telemetry[7] & 0x01) != 0);
+    return IntBStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setIntBStatus(bool bval)
 {
-    telemetry[7] &= (~0x01);
-    telemetry[7] |= bval ? 0x01 : 0x00;
+    IntBStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getURBStatus()
 {
-    return ((telemetry[7] & 0x02) != 0);
+    return URBStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setURBStatus(bool bval)
 {
-    telemetry[7] &= (~0x02);
-    telemetry[7] |= bval ? 0x02 : 0x00;
+    URBStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getSAYpStatus()
 {
-    return ((telemetry[7] & 0x04) != 0);
+    return SAYpStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAYpStatus(bool bval)
 {
-    telemetry[7] &= (~0x04);
-    telemetry[7] |= bval ? 0x04 : 0x00;
+    SAYpStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getSAYmStatus()
 {
-    return ((telemetry[7] & 0x08) != 0);
+    return SAYmStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAYmStatus(bool bval)
 {
-    telemetry[7] &= (~0x08);
-    telemetry[7] |= bval ? 0x08 : 0x00;
+    SAYmStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getSAXpStatus()
 {
-    return ((telemetry[7] & 0x10) != 0);
+    return SAXpStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAXpStatus(bool bval)
 {
-    telemetry[7] &= (~0x10);
-    telemetry[7] |= bval ? 0x10 : 0x00;
+    SAXpStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getSAXmStatus()
 {
-    return ((telemetry[7] & 0x20) != 0);
+    return SAXmStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAXmStatus(bool bval)
 {
-    telemetry[7] &= (~0x20);
-    telemetry[7] |= bval ? 0x20 : 0x00;
+    SAXmStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getBattStatus()
 {
-    return ((telemetry[7] & 0x40) != 0);
+    return BattStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setBattStatus(bool bval)
 {
-    telemetry[7] &= (~0x40);
-    telemetry[7] |= bval ? 0x40 : 0x00;
+    BattStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getBattINAStatus()
 {
-    return ((telemetry[7] & 0x80) != 0);
+    return BattINAStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setBattINAStatus(bool bval)
 {
-    telemetry[7] &= (~0x80);
-    telemetry[7] |= bval ? 0x80 : 0x00;
+    BattINAStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getSAYpTmpStatus()
 {
-    return ((telemetry[8] & 0x01) != 0);
+    return SAYpTmpStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAYpTmpStatus(bool bval)
 {
-    telemetry[8] &= (~0x01);
-    telemetry[8] |= bval ? 0x01 : 0x00;
+    SAYpTmpStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getSAYmTmpStatus()
 {
-    return ((telemetry[8] & 0x02) != 0);
+    return SAYmTmpStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAYmTmpStatus(bool bval)
 {
-    telemetry[8] &= (~0x02);
-    telemetry[8] |= bval ? 0x02 : 0x00;
+    SAYmTmpStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getSAXpTmpStatus()
 {
-    return ((telemetry[8] & 0x04) != 0);
+    return SAXpTmpStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAXpTmpStatus(bool bval)
 {
-    telemetry[8] &= (~0x04);
-    telemetry[8] |= bval ? 0x04 : 0x00;
+    SAXpTmpStatusField::set(telemetry, bval);
 }
 
 bool EPSTelemetryContainer::getSAXmTmpStatus()
 {
-    return ((telemetry[8] & 0x08) != 0);
+    return SAXmTmpStatusField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAXmTmpStatus(bool bval)
 {
-    telemetry[8] &= (~0x08);
-    telemetry[8] |= bval ? 0x08 : 0x00;
+    SAXmTmpStatusField::set(telemetry, bval);
 }
 
 signed short EPSTelemetryContainer::getIntBCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[79];
-    ((unsigned char *)&ushort)[0] = telemetry[80];
-    return ushort;
+    return IntBCurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setIntBCurrent(signed short ushort)
 {
-    telemetry[79] = ((unsigned char *)&ushort)[1];
-    telemetry[80] = ((unsigned char *)&ushort)[0];
+    IntBCurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getIntBVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[81];
-    ((unsigned char *)&ushort)[0] = telemetry[82];
-    return ushort;
+    return IntBVoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setIntBVoltage(unsigned short ushort)
 {
-    telemetry[81] = ((unsigned char *)&ushort)[1];
-    telemetry[82] = ((unsigned char *)&ushort)[0];
+    IntBVoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getURBCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[83];
-    ((unsigned char *)&ushort)[0] = telemetry[84];
-    return ushort;
+    return URBCurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setURBCurrent(signed short ushort)
 {
-    telemetry[83] = ((unsigned char *)&ushort)[1];
-    telemetry[84] = ((unsigned char *)&ushort)[0];
+    URBCurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getURBVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[85];
-    ((unsigned char *)&ushort)[0] = telemetry[86];
-    return ushort;
+    return URBVoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setURBVoltage(unsigned short ushort)
 {
-    telemetry[85] = ((unsigned char *)&ushort)[1];
-    telemetry[86] = ((unsigned char *)&ushort)[0];
+    URBVoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getB1Current()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[50];
-    ((unsigned char *)&ushort)[0] = telemetry[51];
-    return ushort;
+    return B1CurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB1Current(signed short ushort)
 {
-    telemetry[50] = ((unsigned char *)&ushort)[1];
-    telemetry[51] = ((unsigned char *)&ushort)[0];
+    B1CurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getB1Voltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[58];
-    ((unsigned char *)&ushort)[0] = telemetry[59];
-    return ushort;
+    return B1VoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB1Voltage(unsigned short ushort)
 {
-    telemetry[58] = ((unsigned char *)&ushort)[1];
-    telemetry[59] = ((unsigned char *)&ushort)[0];
+    B1VoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getB2Current()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[52];
-    ((unsigned char *)&ushort)[0] = telemetry[53];
-    return ushort;
+    return B2CurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB2Current(signed short ushort)
 {
-    telemetry[52] = ((unsigned char *)&ushort)[1];
-    telemetry[53] = ((unsigned char *)&ushort)[0];
+    B2CurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getB2Voltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[60];
-    ((unsigned char *)&ushort)[0] = telemetry[61];
-    return ushort;
+    return B2VoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB2Voltage(unsigned short ushort)
 {
-    telemetry[60] = ((unsigned char *)&ushort)[1];
-    telemetry[61] = ((unsigned char *)&ushort)[0];
+    B2VoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getB3Current()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[54];
-    ((unsigned char *)&ushort)[0] = telemetry[55];
-    return ushort;
+    return B3CurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB3Current(signed short ushort)
 {
-    telemetry[54] = ((unsigned char *)&ushort)[1];
-    telemetry[55] = ((unsigned char *)&ushort)[0];
+    B3CurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getB3Voltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[62];
-    ((unsigned char *)&ushort)[0] = telemetry[63];
-    return ushort;
+    return B3VoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB3Voltage(unsigned short ushort)
 {
-    telemetry[62] = ((unsigned char *)&ushort)[1];
-    telemetry[63] = ((unsigned char *)&ushort)[0];
+    B3VoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getB4Current()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[56];
-    ((unsigned char *)&ushort)[0] = telemetry[57];
-    return ushort;
+    return B4CurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB4Current(signed short ushort)
 {
-    telemetry[56] = ((unsigned char *)&ushort)[1];
-    telemetry[57] = ((unsigned char *)&ushort)[0];
+    B4CurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getB4Voltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[64];
-    ((unsigned char *)&ushort)[0] = telemetry[65];
-    return ushort;
+    return B4VoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setB4Voltage(unsigned short ushort)
 {
-    telemetry[64] = ((unsigned char *)&ushort)[1];
-    telemetry[65] = ((unsigned char *)&ushort)[0];
+    B4VoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSAYpCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[18];
-    ((unsigned char *)&ushort)[0] = telemetry[19];
-    return ushort;
+    return SAYpCurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAYpCurrent(signed short ushort)
 {
-    telemetry[18] = ((unsigned char *)&ushort)[1];
-    telemetry[19] = ((unsigned char *)&ushort)[0];
+    SAYpCurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getSAYpVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[26];
-    ((unsigned char *)&ushort)[0] = telemetry[27];
-    return ushort;
+    return SAYpVoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAYpVoltage(unsigned short ushort)
 {
-    telemetry[26] = ((unsigned char *)&ushort)[1];
-    telemetry[27] = ((unsigned char *)&ushort)[0];
+    SAYpVoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSAYmCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[20];
-    ((unsigned char *)&ushort)[0] = telemetry[21];
-    return ushort;
+    return SAYmCurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAYmCurrent(signed short ushort)
 {
-    telemetry[20] = ((unsigned char *)&ushort)[1];
-    telemetry[21] = ((unsigned char *)&ushort)[0];
+    SAYmCurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getSAYmVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[28];
-    ((unsigned char *)&ushort)[0] = telemetry[29];
-    return ushort;
+    return SAYmVoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAYmVoltage(unsigned short ushort)
 {
-    telemetry[28] = ((unsigned char *)&ushort)[1];
-    telemetry[29] = ((unsigned char *)&ushort)[0];
+    SAYmVoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSAXpCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[22];
-    ((unsigned char *)&ushort)[0] = telemetry[23];
-    return ushort;
+    return SAXpCurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAXpCurrent(signed short ushort)
 {
-    telemetry[22] = ((unsigned char *)&ushort)[1];
-    telemetry[23] = ((unsigned char *)&ushort)[0];
+    SAXpCurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getSAXpVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[30];
-    ((unsigned char *)&ushort)[0] = telemetry[31];
-    return ushort;
+    return SAXpVoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAXpVoltage(unsigned short ushort)
 {
-    telemetry[30] = ((unsigned char *)&ushort)[1];
-    telemetry[31] = ((unsigned char *)&ushort)[0];
+    SAXpVoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSAXmCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[24];
-    ((unsigned char *)&ushort)[0] = telemetry[25];
-    return ushort;
+    return SAXmCurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAXmCurrent(signed short ushort)
 {
-    telemetry[24] = ((unsigned char *)&ushort)[1];
-    telemetry[25] = ((unsigned char *)&ushort)[0];
+    SAXmCurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getSAXmVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[32];
-    ((unsigned char *)&ushort)[0] = telemetry[33];
-    return ushort;
+    return SAXmVoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAXmVoltage(unsigned short ushort)
 {
-    telemetry[32] = ((unsigned char *)&ushort)[1];
-    telemetry[33] = ((unsigned char *)&ushort)[0];
+    SAXmVoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSPYpCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[34];
-    ((unsigned char *)&ushort)[0] = telemetry[35];
-    return ushort;
+    return SPYpCurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPYpCurrent(signed short ushort)
 {
-    telemetry[34] = ((unsigned char *)&ushort)[1];
-    telemetry[35] = ((unsigned char *)&ushort)[0];
+    SPYpCurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getSPYpVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[42];
-    ((unsigned char *)&ushort)[0] = telemetry[43];
-    return ushort;
+    return SPYpVoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPYpVoltage(unsigned short ushort)
 {
-    telemetry[42] = ((unsigned char *)&ushort)[1];
-    telemetry[43] = ((unsigned char *)&ushort)[0];
+    SPYpVoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSPYmCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[36];
-    ((unsigned char *)&ushort)[0] = telemetry[37];
-    return ushort;
+    return SPYmCurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPYmCurrent(signed short ushort)
 {
-    telemetry[36] = ((unsigned char *)&ushort)[1];
-    telemetry[37] = ((unsigned char *)&ushort)[0];
+    SPYmCurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getSPYmVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[44];
-    ((unsigned char *)&ushort)[0] = telemetry[45];
-    return ushort;
+    return SPYmVoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPYmVoltage(unsigned short ushort)
 {
-    telemetry[44] = ((unsigned char *)&ushort)[1];
-    telemetry[45] = ((unsigned char *)&ushort)[0];
+    SPYmVoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSPXpCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[38];
-    ((unsigned char *)&ushort)[0] = telemetry[39];
-    return ushort;
+    return SPXpCurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPXpCurrent(signed short ushort)
 {
-    telemetry[38] = ((unsigned char *)&ushort)[1];
-    telemetry[39] = ((unsigned char *)&ushort)[0];
+    SPXpCurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getSPXpVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[46];
-    ((unsigned char *)&ushort)[0] = telemetry[47];
-    return ushort;
+    return SPXpVoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPXpVoltage(unsigned short ushort)
 {
-    telemetry[46] = ((unsigned char *)&ushort)[1];
-    telemetry[47] = ((unsigned char *)&ushort)[0];
+    SPXpVoltageField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSPXmCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[40];
-    ((unsigned char *)&ushort)[0] = telemetry[41];
-    return ushort;
+    return SPXmCurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPXmCurrent(signed short ushort)
 {
-    telemetry[40] = ((unsigned char *)&ushort)[1];
-    telemetry[41] = ((unsigned char *)&ushort)[0];
+    SPXmCurrentField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getSPXmVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[48];
-    ((unsigned char *)&ushort)[0] = telemetry[49];
-    return ushort;
+    return SPXmVoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSPXmVoltage(unsigned short ushort)
 {
-    telemetry[48] = ((unsigned char *)&ushort)[1];
-    telemetry[49] = ((unsigned char *)&ushort)[0];
+    SPXmVoltageField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getBattVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[66];
-    ((unsigned char *)&ushort)[0] = telemetry[67];
-    return ushort;
+    return BattVoltageField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setBattVoltage(unsigned short ushort)
 {
-    telemetry[66] = ((unsigned char *)&ushort)[1];
-    telemetry[67] = ((unsigned char *)&ushort)[0];
+    BattVoltageField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getBattVoltage1()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[68];
-    ((unsigned char *)&ushort)[0] = telemetry[69];
-    return ushort;
+    return BattVoltage1Field::get(telemetry);
 }
 
 void EPSTelemetryContainer::setBattVoltage1(unsigned short ushort)
 {
-    telemetry[68] = ((unsigned char *)&ushort)[1];
-    telemetry[69] = ((unsigned char *)&ushort)[0];
+    BattVoltage1Field::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getBattCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[70];
-    ((unsigned char *)&ushort)[0] = telemetry[71];
-    return ushort;
+    return BattCurrentField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setBattCurrent(signed short ushort)
 {
-    telemetry[70] = ((unsigned char *)&ushort)[1];
-    telemetry[71] = ((unsigned char *)&ushort)[0];
+    BattCurrentField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getBattTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[74];
-    ((unsigned char *)&ushort)[0] = telemetry[75];
-    return ushort;
+    return BattTemperatureField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setBattTemperature(signed short ushort)
 {
-    telemetry[74] = ((unsigned char *)&ushort)[1];
-    telemetry[75] = ((unsigned char *)&ushort)[0];
+    BattTemperatureField::set(telemetry, ushort);
 }
 
 unsigned short EPSTelemetryContainer::getBattCapacity()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[72];
-    ((unsigned char *)&ushort)[0] = telemetry[73];
-    return ushort;
+    return BattCapacityField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setBattCapacity(unsigned short ushort)
 {
-    telemetry[72] = ((unsigned char *)&ushort)[1];
-    telemetry[73] = ((unsigned char *)&ushort)[0];
+    BattCapacityField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSAYpTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[10];
-    ((unsigned char *)&ushort)[0] = telemetry[11];
-    return ushort;
+    return SAYpTemperatureField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAYpTemperature(signed short ushort)
 {
-    telemetry[10] = ((unsigned char *)&ushort)[1];
-    telemetry[11] = ((unsigned char *)&ushort)[0];
+    SAYpTemperatureField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSAYmTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[12];
-    ((unsigned char *)&ushort)[0] = telemetry[13];
-    return ushort;
+    return SAYmTemperatureField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAYmTemperature(signed short ushort)
 {
-    telemetry[12] = ((unsigned char *)&ushort)[1];
-    telemetry[13] = ((unsigned char *)&ushort)[0];
+    SAYmTemperatureField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSAXpTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[14];
-    ((unsigned char *)&ushort)[0] = telemetry[15];
-    return ushort;
+    return SAXpTemperatureField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAXpTemperature(signed short ushort)
 {
-    telemetry[14] = ((unsigned char *)&ushort)[1];
-    telemetry[15] = ((unsigned char *)&ushort)[0];
+    SAXpTemperatureField::set(telemetry, ushort);
 }
 
 signed short EPSTelemetryContainer::getSAXmTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[16];
-    ((unsigned char *)&ushort)[0] = telemetry[17];
-    return ushort;
+    return SAXmTemperatureField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setSAXmTemperature(signed short ushort)
 {
-    telemetry[16] = ((unsigned char *)&ushort)[1];
-    telemetry[17] = ((unsigned char *)&ushort)[0];
+    SAXmTemperatureField::set(telemetry, ushort);
 }
 
 unsigned char EPSTelemetryContainer::getBusStatus()
@@ -798,14 +611,10 @@ void EPSTelemetryContainer::setBusErrorStatus(unsigned char uchar)
 
 signed short EPSTelemetryContainer::getMCUTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[77];
-    ((unsigned char *)&ushort)[0] = telemetry[78];
-    return ushort;
+    return MCUTemperatureField::get(telemetry);
 }
 
 void EPSTelemetryContainer::setMCUTemperature(signed short ushort)
 {
-    telemetry[77] = ((unsigned char *)&ushort)[1];
-    telemetry[78] = ((unsigned char *)&ushort)[0];
+    MCUTemperatureField::set(telemetry, ushort);
 }
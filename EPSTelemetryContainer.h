@@ -9,6 +9,7 @@
 #define EPSTELEMETRYCONTAINER_H_
 
 #include "TelemetryContainer.h"
+#include "TelemetryField.h"
 
 #define EPS_CONTAINER_SIZE  87
 class EPSTelemetryContainer : public TelemetryContainer
@@ -17,8 +18,70 @@ protected:
     unsigned char telemetry[EPS_CONTAINER_SIZE];
 
 public:
-    virtual int size();
-    virtual unsigned char * getArray();
+    // Fields of the telemetry array (see TelemetryField.h)
+    typedef TelemetryField<unsigned long, 0, 4> UpTimeField;
+    typedef TelemetryFlag<7, 0x01> IntBStatusField;
+    typedef TelemetryFlag<7, 0x02> URBStatusField;
+    typedef TelemetryFlag<7, 0x04> SAYpStatusField;
+    typedef TelemetryFlag<7, 0x08> SAYmStatusField;
+    typedef TelemetryFlag<7, 0x10> SAXpStatusField;
+    typedef TelemetryFlag<7, 0x20> SAXmStatusField;
+    typedef TelemetryFlag<7, 0x40> BattStatusField;
+    typedef TelemetryFlag<7, 0x80> BattINAStatusField;
+    typedef TelemetryFlag<8, 0x01> SAYpTmpStatusField;
+    typedef TelemetryFlag<8, 0x02> SAYmTmpStatusField;
+    typedef TelemetryFlag<8, 0x04> SAXpTmpStatusField;
+    typedef TelemetryFlag<8, 0x08> SAXmTmpStatusField;
+    typedef TelemetryFlag<8, 0x10> B1StatusField;
+    typedef TelemetryFlag<8, 0x20> B2StatusField;
+    typedef TelemetryFlag<8, 0x40> B3StatusField;
+    typedef TelemetryFlag<8, 0x80> B4StatusField;
+    typedef TelemetryFlag<9, 0x01> SPYpStatusField;
+    typedef TelemetryFlag<9, 0x02> SPYmStatusField;
+    typedef TelemetryFlag<9, 0x04> SPXpStatusField;
+    typedef TelemetryFlag<9, 0x08> SPXmStatusField;
+    typedef TelemetryField<signed short, 10, 2> SAYpTemperatureField;
+    typedef TelemetryField<signed short, 12, 2> SAYmTemperatureField;
+    typedef TelemetryField<signed short, 14, 2> SAXpTemperatureField;
+    typedef TelemetryField<signed short, 16, 2> SAXmTemperatureField;
+    typedef TelemetryField<signed short, 18, 2> SAYpCurrentField;
+    typedef TelemetryField<signed short, 20, 2> SAYmCurrentField;
+    typedef TelemetryField<signed short, 22, 2> SAXpCurrentField;
+    typedef TelemetryField<signed short, 24, 2> SAXmCurrentField;
+    typedef TelemetryField<unsigned short, 26, 2> SAYpVoltageField;
+    typedef TelemetryField<unsigned short, 28, 2> SAYmVoltageField;
+    typedef TelemetryField<unsigned short, 30, 2> SAXpVoltageField;
+    typedef TelemetryField<unsigned short, 32, 2> SAXmVoltageField;
+    typedef TelemetryField<signed short, 34, 2> SPYpCurrentField;
+    typedef TelemetryField<signed short, 36, 2> SPYmCurrentField;
+    typedef TelemetryField<signed short, 38, 2> SPXpCurrentField;
+    typedef TelemetryField<signed short, 40, 2> SPXmCurrentField;
+    typedef TelemetryField<unsigned short, 42, 2> SPYpVoltageField;
+    typedef TelemetryField<unsigned short, 44, 2> SPYmVoltageField;
+    typedef TelemetryField<unsigned short, 46, 2> SPXpVoltageField;
+    typedef TelemetryField<unsigned short, 48, 2> SPXmVoltageField;
+    typedef TelemetryField<signed short, 50, 2> B1CurrentField;
+    typedef TelemetryField<signed short, 52, 2> B2CurrentField;
+    typedef TelemetryField<signed short, 54, 2> B3CurrentField;
+    typedef TelemetryField<signed short, 56, 2> B4CurrentField;
+    typedef TelemetryField<unsigned short, 58, 2> B1VoltageField;
+    typedef TelemetryField<unsigned short, 60, 2> B2VoltageField;
+    typedef TelemetryField<unsigned short, 62, 2> B3VoltageField;
+    typedef TelemetryField<unsigned short, 64, 2> B4VoltageField;
+    typedef TelemetryField<unsigned short, 66, 2> BattVoltageField;
+    typedef TelemetryField<unsigned short, 68, 2> BattVoltage1Field;
+    typedef TelemetryField<signed short, 70, 2> BattCurrentField;
+    typedef TelemetryField<unsigned short, 72, 2> BattCapacityField;
+    typedef TelemetryField<signed short, 74, 2> BattTemperatureField;
+    typedef TelemetryField<signed short, 77, 2> MCUTemperatureField;
+    typedef TelemetryField<signed short, 79, 2> IntBCurrentField;
+    typedef TelemetryField<unsigned short, 81, 2> IntBVoltageField;
+    typedef TelemetryField<signed short, 83, 2> URBCurrentField;
+    typedef TelemetryField<unsigned short, 85, 2> URBVoltageField;
+
+    // The telemetry array and its size
+    virtual int size() { return EPS_CONTAINER_SIZE; }
+    virtual unsigned char * getArray() { return telemetry; }
 
     unsigned long getUpTime();
     void setUpTime(unsigned long ulong);
@@ -41,6 +41,8 @@
 #include "PROPTelemetryContainer.h"
 #include "StateMachine.h"
 #include "Communication.h"
+#include "Checksum.h"
+#include "SDCardAccess.h"
 #include "OBCTelemetryContainer.h"
 
 #define FCLOCK 48000000
@@ -1,10 +1,17 @@
 /*
  * OBCFRAMAccess.cpp
  *
- *  Start address + 0~3     Used to identify whether the block is written
- *                          (1: written, other values: not written)
- *  Start address + 4       Size of the array
- *  Start address + 5~      The array
+ *  A block holds two copies (slots A and B) of the array, each slot is:
+ *  Slot + 0~3          Sequence number (MSB first), incremented at every write
+ *  Slot + 4            Size of the array
+ *  Slot + 5~           The array
+ *  After the array     CRC-32 of the address of the block, the sequence number, the size
+ *                      and the array (4 bytes, MSB first)
+ *
+ *  A write only goes to the slot which doesn't hold the newest copy, and a slot is
+ *  valid only if its CRC matches. A reset in the middle of a write leaves that slot
+ *  invalid, and the other slot still holds the previous copy. Both slots are read in
+ *  a single SPI transaction and the valid one with the newest sequence number is used.
  *
  *  Created on: June 26, 2020
  *      Author: Zhuoheng
@@ -12,58 +19,337 @@
  */
 
 #include "OBCFramAccess.h"
+#include "DirtyLines.h"
+#include "Checksum.h"
+#include "BigEndian.h"
+#include <string.h>
+
+#define SLOT_HEADER_SIZE        5       // Sequence number and size
+
+// What is known about the two slots of a block
+typedef struct BlockState
+{
+    unsigned long sequence;     // Sequence number of the newest copy
+    unsigned char newest;       // Slot of the newest copy (0: A, 1: B)
+    unsigned char synced;       // Bit n: slot n holds the array of the caller (newest slot),
+                                // or the previous array except previousLines (other slot)
+    unsigned long previousLines;// Lines changed by the last write
+} BlockState;
+
+// Cached health of the FRAM, see OBCFramSetPingPeriod()
+bool framAvailable = false;
+unsigned short framPingPeriod = OBCFRAM_DEFAULT_PING_PERIOD;
+unsigned short operationsSincePing;
+unsigned long framPingCount;
+
+// Both slots of the block being read, or the slot being written
+unsigned char framBlock[OBCFramBlockSize(OBCFRAM_MAX_ARRAY_SIZE)];
+
+// All the blocks, read at once by OBCFramRestore()
+unsigned char framLayout[OBCFRAM_LAYOUT_END - OBCFRAM_LAYOUT_START];
+
+BlockState blockStates[OBCFRAM_BLOCKS];
+BlockState otherBlockState;     // Used for an address which isn't one of the blocks
+unsigned long framBytesWritten;
+
+/**
+ *
+ *  Check whether the FRAM is available, it only pings when the cached state is too old
+ *
+ */
+bool FramAvailable(MB85RS &fram)
+{
+    if (framAvailable && (operationsSincePing < framPingPeriod))
+    {
+        operationsSincePing++;
+        return true;
+    }
+
+    framAvailable = fram.ping();
+    framPingCount++;
+    operationsSincePing = 0;
+    if (!framAvailable)
+    {
+        for (unsigned int i = 0; i < OBCFRAM_BLOCKS; i++)
+        {
+            blockStates[i].synced = 0;
+        }
+    }
+    return framAvailable;
+}
+
+/**
+ *
+ *  Cached state of the block starting at an address
+ *
+ */
+BlockState *GetBlockState(unsigned long startAddress)
+{
+    for (unsigned int i = 0; i < OBCFRAM_BLOCKS; i++)
+    {
+        if (obcFramBlocks[i][0] == startAddress)
+        {
+            return &blockStates[i];
+        }
+    }
+
+    otherBlockState.synced = 0;
+    return &otherBlockState;
+}
+
+/**
+ *
+ *  First part of the CRC of a slot: the address of the block, so a copy is never
+ *  taken for the one of another block when the layout changes
+ *
+ */
+unsigned long BlockSeed(unsigned long startAddress)
+{
+    unsigned char address[4];
+
+    BigEndianStore32(address, startAddress);
+    return ChecksumCRC32(CHECKSUM_CRC32_INIT, address, 4);
+}
+
+/**
+ *
+ *  Find the newest valid copy in both slots of a block
+ *
+ */
+int CheckSlots(unsigned char *block, unsigned long startAddress, int arraySize, BlockState *state)
+{
+    int result = FRAM_NOT_WRITTEN;
+    unsigned char *slot;
+    unsigned long sequence;
+
+    for (int i = 0; i < 2; i++)
+    {
+        slot = &block[i * OBCFramSlotSize(arraySize)];
+        if (slot[4] != arraySize)
+        {
+            if (result == FRAM_NOT_WRITTEN)
+            {
+                result = FRAM_WRONG_SIZE;
+            }
+            continue;
+        }
+
+        if (ChecksumCRC32(BlockSeed(startAddress), slot, SLOT_HEADER_SIZE + arraySize)
+            != BigEndianLoad32(&slot[SLOT_HEADER_SIZE + arraySize]))
+        {
+            continue;
+        }
+
+        // The sequence number wraps around: the newest is the one ahead of the other
+        sequence = BigEndianLoad32(&slot[0]);
+        if ((result != FRAM_OPERATION_SUCCESS) || ((long)(sequence - state->sequence) > 0))
+        {
+            state->sequence = sequence;
+            state->newest = i;
+            result = FRAM_OPERATION_SUCCESS;
+        }
+    }
+
+    if (result != FRAM_OPERATION_SUCCESS)
+    {
+        // Nothing valid: the next write goes to slot A with sequence number 1
+        state->sequence = 0;
+        state->newest = 1;
+    }
+    return result;
+}
+
+/**
+ *
+ *  Read both slots of a block (one transaction) and find the newest valid copy
+ *
+ */
+int ReadSlots(MB85RS &fram, unsigned long startAddress, int arraySize, BlockState *state)
+{
+    fram.read(startAddress, framBlock, OBCFramSlotSize(arraySize) + SLOT_HEADER_SIZE + arraySize + 4);
+    return CheckSlots(framBlock, startAddress, arraySize, state);
+}
 
 int OBCFramRead(MB85RS &fram, unsigned long startAddress, unsigned char *array, int arraySize)
 {
-    unsigned long written;
-    unsigned char size;
+    BlockState *state = GetBlockState(startAddress);
+    int result;
 
     // Check whether the FRAM is available
-    if (fram.ping() == false)
+    if (FramAvailable(fram) == false)
     {
         return FRAM_NOT_AVAILABLE;
     }
 
-    // Check whether the block is available
-    fram.read(startAddress, (unsigned char *)&written, 4);
-    if (written != 1)
+    if (arraySize > OBCFRAM_MAX_ARRAY_SIZE || arraySize == 0)
     {
-        return FRAM_NOT_WRITTEN;
+        return FRAM_WRONG_SIZE;
     }
 
-    // Check the size of the block
-    fram.read(startAddress + 4, &size, 1);
-    if (size != arraySize)
+    // A missing FRAM reads as invalid slots, so it's pinged again at the next operation
+    result = ReadSlots(fram, startAddress, arraySize, state);
+    if (result != FRAM_OPERATION_SUCCESS)
     {
-        return FRAM_WRONG_SIZE;
+        framAvailable = false;
+        state->synced = 0;
+        return result;
     }
 
-    // Read the block
-    fram.read(startAddress + 5, array, arraySize);
+    memcpy(array, &framBlock[state->newest * OBCFramSlotSize(arraySize) + SLOT_HEADER_SIZE], arraySize);
+    state->synced = 1 << state->newest;
+    state->previousLines = DIRTY_ALL_LINES;
 
     return FRAM_OPERATION_SUCCESS;
 }
 
+int OBCFramRestore(MB85RS &fram, unsigned char *arrays[], int *results)
+{
+    unsigned char *block;
+    int restored = 0;
+
+    if (FramAvailable(fram) == false)
+    {
+        for (unsigned int i = 0; i < OBCFRAM_BLOCKS; i++)
+        {
+            results[i] = FRAM_NOT_AVAILABLE;
+        }
+        return 0;
+    }
+
+    // The blocks are packed: one transaction reads them all
+    fram.read(OBCFRAM_LAYOUT_START, framLayout, OBCFRAM_LAYOUT_END - OBCFRAM_LAYOUT_START);
+
+    for (unsigned int i = 0; i < OBCFRAM_BLOCKS; i++)
+    {
+        block = &framLayout[obcFramBlocks[i][0] - OBCFRAM_LAYOUT_START];
+        results[i] = CheckSlots(block, obcFramBlocks[i][0], obcFramBlocks[i][1], &blockStates[i]);
+        if (results[i] != FRAM_OPERATION_SUCCESS)
+        {
+            blockStates[i].synced = 0;
+            continue;
+        }
+
+        memcpy(arrays[i], &block[blockStates[i].newest * OBCFramSlotSize(obcFramBlocks[i][1]) + SLOT_HEADER_SIZE],
+               obcFramBlocks[i][1]);
+        blockStates[i].synced = 1 << blockStates[i].newest;
+        blockStates[i].previousLines = DIRTY_ALL_LINES;
+        restored++;
+    }
+
+    // A missing FRAM reads as invalid slots, so it's pinged again at the next operation
+    if (restored == 0)
+    {
+        framAvailable = false;
+    }
+    return restored;
+}
+
 int OBCFramWrite(MB85RS &fram, unsigned long startAddress, unsigned char *array, int arraySize)
 {
-    unsigned long written = 1;
+    return OBCFramWriteLines(fram, startAddress, array, arraySize, DIRTY_ALL_LINES);
+}
+
+int OBCFramWriteLines(MB85RS &fram, unsigned long startAddress, unsigned char *array, int arraySize, unsigned long dirtyLines)
+{
+    BlockState *state = GetBlockState(startAddress);
+    unsigned long slotAddress;
+    unsigned long lines;
+    unsigned char target;
+    unsigned char crc[4];
+    int line, first, last;
 
     // Check whether the FRAM is available
-    if (fram.ping() == false)
+    if (FramAvailable(fram) == false)
     {
         return FRAM_NOT_AVAILABLE;
     }
 
     // Check the size of the block
-    if (arraySize > 295 || arraySize == 0) // 295 is the maximum size of an array at this moment
+    if (arraySize > OBCFRAM_MAX_ARRAY_SIZE || arraySize == 0)
     {
         return FRAM_WRONG_SIZE;
     }
-    else
+
+    if ((dirtyLines == 0) && (state->synced & (1 << state->newest)))
     {
-        fram.write(startAddress + 4, (unsigned char *)&arraySize, 1);
-        fram.write(startAddress + 5, array, arraySize);
-        fram.write(startAddress, (unsigned char *)&written, 4);
         return FRAM_OPERATION_SUCCESS;
     }
+
+    // The sequence number of the newest copy is needed (first write since boot)
+    if (state->synced == 0)
+    {
+        ReadSlots(fram, startAddress, arraySize, state);
+    }
+
+    target = 1 - state->newest;
+    slotAddress = startAddress + target * OBCFramSlotSize(arraySize);
+
+    // The other slot holds the previous array: it misses the lines of the last write too
+    lines = ((state->synced & (1 << target)) != 0) ? (dirtyLines | state->previousLines) : DIRTY_ALL_LINES;
+
+    BigEndianStore32(&framBlock[0], state->sequence + 1);
+    framBlock[4] = arraySize;
+
+    if (lines == DIRTY_ALL_LINES)
+    {
+        // Build the slot and write it at once
+        memcpy(&framBlock[SLOT_HEADER_SIZE], array, arraySize);
+        BigEndianStore32(&framBlock[SLOT_HEADER_SIZE + arraySize],
+                         ChecksumCRC32(BlockSeed(startAddress), framBlock, SLOT_HEADER_SIZE + arraySize));
+        fram.write(slotAddress, framBlock, SLOT_HEADER_SIZE + arraySize + 4);
+        framBytesWritten += SLOT_HEADER_SIZE + arraySize + 4;
+    }
+    else
+    {
+        // Write every run of changed lines in one transaction
+        line = 0;
+        while (line * DIRTY_LINE_SIZE < arraySize)
+        {
+            if ((lines & (1UL << line)) == 0)
+            {
+                line++;
+                continue;
+            }
+
+            first = line * DIRTY_LINE_SIZE;
+            while ((line * DIRTY_LINE_SIZE < arraySize) && ((lines & (1UL << line)) != 0))
+            {
+                line++;
+            }
+            last = (line * DIRTY_LINE_SIZE < arraySize) ? line * DIRTY_LINE_SIZE : arraySize;
+
+            fram.write(slotAddress + SLOT_HEADER_SIZE + first, &array[first], last - first);
+            framBytesWritten += last - first;
+        }
+
+        // Then the header and the CRC: until both are written, the slot is invalid
+        BigEndianStore32(crc, ChecksumCRC32(ChecksumCRC32(BlockSeed(startAddress), framBlock, SLOT_HEADER_SIZE),
+                                            array, arraySize));
+        fram.write(slotAddress, framBlock, SLOT_HEADER_SIZE);
+        fram.write(slotAddress + SLOT_HEADER_SIZE + arraySize, crc, 4);
+        framBytesWritten += SLOT_HEADER_SIZE + 4;
+    }
+
+    // The written slot is the newest one, the other one holds the previous array
+    state->synced = (1 << target) | (((state->synced & (1 << state->newest)) != 0) ? (1 << state->newest) : 0);
+    state->previousLines = dirtyLines;
+    state->newest = target;
+    state->sequence++;
+
+    return FRAM_OPERATION_SUCCESS;
+}
+
+void OBCFramSetPingPeriod(unsigned short pingPeriod)
+{
+    framPingPeriod = pingPeriod;
+}
+
+unsigned long OBCFramPingCount()
+{
+    return framPingCount;
+}
+
+unsigned long OBCFramBytesWritten()
+{
+    return framBytesWritten;
 }
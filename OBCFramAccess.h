@@ -6,9 +6,9 @@
  *      2. If we update onboard software, the size of telemetry / container may be changed
  *      3. We need to make sure that both FRAM and SD card is erased before the launch
  *  OBCFRAMAccess provides a simple solution to problem 1 and 2.
- *      - It checks 4 bytes to see whether the FRAM is written (which means the error
- *      probability is 1/2^32).
- *      - It gives 200 bytes for each containers, which is enough for expansion.
+ *      - It checks a CRC-32 to see whether the block is completely written, and keeps
+ *      two copies so a reset during a write never loses the previous one.
+ *      - The blocks are sized from the containers at compile time, see OBCFramLayout.h.
  *  However, problem 3 remains unresolved (TODO)!
  *
  *  Created on: June 26, 2020
@@ -20,18 +20,14 @@
 #define OBCFRAMACCESS_H_
 
 #include "MB85RS.h"
+#include "OBCFramLayout.h"
 
 #define FRAM_NOT_AVAILABLE      0
 #define FRAM_OPERATION_SUCCESS  1
 #define FRAM_NOT_WRITTEN        2
 #define FRAM_WRONG_SIZE         3
 
-#define OBCFRAM_ADBTM_ADDR      5000
-#define OBCFRAM_ADCSTM_ADDR     5300
-#define OBCFRAM_COMMSTM_ADDR    5600
-#define OBCFRAM_EPSTM_ADDR      5900
-#define OBCFRAM_PROPTM_ADDR     6200
-#define OBCFRAM_VARIABLES_ADDR  6500
+#define OBCFRAM_DEFAULT_PING_PERIOD 60  // Operations between two checks of the FRAM (10s in StateMachine())
 
 /**
  *
@@ -41,7 +37,7 @@
  *  Parameter:
  *      MB85RS &fram                    The FRAM object
  *      unsigned long startAddress      Staring address of a block.
- *                                      It should be one of macros define above.
+ *                                      It should be one of the addresses in OBCFramLayout.h
  *      int arraySize                   It's used to compared with the actual size of the
  *                                      array in FRAM.
  *
@@ -55,6 +51,23 @@
  */
 int OBCFramRead(MB85RS &fram, unsigned long startAddress, unsigned char *array, int arraySize);
 
+/**
+ *
+ *  Read all the blocks of OBCFramLayout.h in a single SPI transaction, and every
+ *  valid copy into its array. It's faster than OBCFramRead() for each block at boot.
+ *
+ *  Parameter:
+ *      MB85RS &fram                    The FRAM object
+ *      unsigned char *arrays[]         An array for every block, in the order of
+ *                                      obcFramBlocks (OBCFramLayout.h)
+ *
+ *  Returns:
+ *      OBCFramRestore()                Number of arrays restored
+ *      int *results                    The result of every block, as in OBCFramRead()
+ *
+ */
+int OBCFramRestore(MB85RS &fram, unsigned char *arrays[], int *results);
+
 /**
  *
  *  Write an array to FRAM.
@@ -63,7 +76,7 @@ int OBCFramRead(MB85RS &fram, unsigned long startAddress, unsigned char *array,
  *  Parameter:
  *      MB85RS &fram                    The FRAM object
  *      unsigned long startAddress      Staring address of a block.
- *                                      It should be one of macros define above.
+ *                                      It should be one of the addresses in OBCFramLayout.h
  *      unsigned char *array            The array
  *      int arraySize                   The size of the array
  *
@@ -76,4 +89,54 @@ int OBCFramRead(MB85RS &fram, unsigned long startAddress, unsigned char *array,
  */
 int OBCFramWrite(MB85RS &fram, unsigned long startAddress, unsigned char *array, int arraySize);
 
+/**
+ *
+ *  Write only the changed lines of an array to FRAM (see DirtyLines.h), then the header
+ *  and the CRC. The write goes to the older copy, so the lines changed by the previous
+ *  write are written too. Each run of consecutive changed lines is one SPI transaction.
+ *  The whole copy is written when its content in FRAM is unknown (first writes since
+ *  boot, or after a failed read or ping).
+ *
+ *  Parameter:
+ *      MB85RS &fram                    The FRAM object
+ *      unsigned long startAddress      Staring address of a block.
+ *                                      It should be one of the addresses in OBCFramLayout.h
+ *      unsigned char *array            The array
+ *      int arraySize                   The size of the array
+ *      unsigned long dirtyLines        Lines changed since the last write
+ *
+ *  Returns:
+ *      OBCFramWriteLines()             FRAM_NOT_AVAILABLE or
+ *                                      FRAM_OPERATION_SUCCESS or
+ *                                      FRAM_WRONG_SIZE
+ *
+ */
+int OBCFramWriteLines(MB85RS &fram, unsigned long startAddress, unsigned char *array, int arraySize, unsigned long dirtyLines);
+
+/**
+ *
+ *  The FRAM is pinged at the first operation, after an operation which failed
+ *  and then every pingPeriod operations, instead of before every operation.
+ *
+ *  Parameter:
+ *      unsigned short pingPeriod       Number of operations between two pings
+ *                                      (0: ping before every operation)
+ *
+ */
+void OBCFramSetPingPeriod(unsigned short pingPeriod);
+
+/**
+ *
+ *  Number of pings sent to the FRAM since boot
+ *
+ */
+unsigned long OBCFramPingCount();
+
+/**
+ *
+ *  Number of bytes written to the FRAM since boot (without the SPI opcodes and addresses)
+ *
+ */
+unsigned long OBCFramBytesWritten();
+
 #endif /* OBCFRAMACCESS_H_ */
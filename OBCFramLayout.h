@@ -0,0 +1,89 @@
+/*
+ *  OBCFramLayout.h
+ *
+ *  Map of the FRAM used by the OBC, computed at compile time from the sizes of
+ *  the containers. Every container gets a block holding two copies (slots) of
+ *  its array, see OBCFramAccess.cpp. The blocks are packed one after the other
+ *  and the telemetry history (OBCFramLog.h) uses the rest of the FRAM.
+ *
+ *  Start address       Used by
+ *  0 ~ 4999            Bootloader, software update and HWMonitor (DelfiPQcore)
+ *  5000 ~              Blocks of the containers
+ *  OBCFRAM_LOG_ADDR ~  Telemetry history, up to the end of the FRAM
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef OBCFRAMLAYOUT_H_
+#define OBCFRAMLAYOUT_H_
+
+#include "ADBTelemetryContainer.h"
+#include "ADCSTelemetryContainer.h"
+#include "COMMSTelemetryContainer.h"
+#include "EPSTelemetryContainer.h"
+#include "PROPTelemetryContainer.h"
+#include "OBCTelemetryContainer.h"
+
+#define OBCFRAM_LAYOUT_START        5000
+#define OBCFRAM_MIN_PART_SIZE       32768 // MB85RS256, the smallest FRAM supported
+#define OBCFRAM_ALIGNMENT           4
+#define OBCFRAM_SLOT_OVERHEAD       9     // Sequence number, size and CRC-32
+#define OBCFRAM_MAX_ARRAY_SIZE      255   // The size is stored in one byte
+#define OBCFRAM_LOG_RECORD_SIZE     128
+#define OBCFRAM_LOG_MIN_RECORDS     64    // At least 1 hour of history in the smallest FRAM
+
+constexpr unsigned long OBCFramAlign(unsigned long address, unsigned long alignment)
+{
+    return (address + alignment - 1) / alignment * alignment;
+}
+
+// Space of one copy of an array
+constexpr unsigned long OBCFramSlotSize(int arraySize)
+{
+    return OBCFramAlign(arraySize + OBCFRAM_SLOT_OVERHEAD, OBCFRAM_ALIGNMENT);
+}
+
+// Space of the two copies of an array
+constexpr unsigned long OBCFramBlockSize(int arraySize)
+{
+    return 2 * OBCFramSlotSize(arraySize);
+}
+
+constexpr unsigned long OBCFRAM_ADBTM_ADDR = OBCFRAM_LAYOUT_START;
+constexpr unsigned long OBCFRAM_ADCSTM_ADDR = OBCFRAM_ADBTM_ADDR + OBCFramBlockSize(ADB_CONTAINER_SIZE);
+constexpr unsigned long OBCFRAM_COMMSTM_ADDR = OBCFRAM_ADCSTM_ADDR + OBCFramBlockSize(ADCS_CONTAINER_SIZE);
+constexpr unsigned long OBCFRAM_EPSTM_ADDR = OBCFRAM_COMMSTM_ADDR + OBCFramBlockSize(COMMS_CONTAINER_SIZE);
+constexpr unsigned long OBCFRAM_PROPTM_ADDR = OBCFRAM_EPSTM_ADDR + OBCFramBlockSize(EPS_CONTAINER_SIZE);
+constexpr unsigned long OBCFRAM_VARIABLES_ADDR = OBCFRAM_PROPTM_ADDR + OBCFramBlockSize(PROP_CONTAINER_SIZE);
+constexpr unsigned long OBCFRAM_LAYOUT_END = OBCFRAM_VARIABLES_ADDR + OBCFramBlockSize(OBC_CONTAINER_SIZE);
+
+constexpr unsigned long OBCFRAM_LOG_ADDR = OBCFramAlign(OBCFRAM_LAYOUT_END, OBCFRAM_LOG_RECORD_SIZE);
+
+// Every block (start address and array size) in address order, used by the checks below
+constexpr unsigned long obcFramBlocks[][2] = {
+    {OBCFRAM_ADBTM_ADDR, ADB_CONTAINER_SIZE},
+    {OBCFRAM_ADCSTM_ADDR, ADCS_CONTAINER_SIZE},
+    {OBCFRAM_COMMSTM_ADDR, COMMS_CONTAINER_SIZE},
+    {OBCFRAM_EPSTM_ADDR, EPS_CONTAINER_SIZE},
+    {OBCFRAM_PROPTM_ADDR, PROP_CONTAINER_SIZE},
+    {OBCFRAM_VARIABLES_ADDR, OBC_CONTAINER_SIZE}};
+#define OBCFRAM_BLOCKS (sizeof(obcFramBlocks) / sizeof(obcFramBlocks[0]))
+
+// Block i and the next ones fit their arrays, are aligned and don't overlap
+constexpr bool OBCFramBlocksValid(unsigned int i)
+{
+    return (i >= OBCFRAM_BLOCKS)
+           || ((obcFramBlocks[i][1] > 0) && (obcFramBlocks[i][1] <= OBCFRAM_MAX_ARRAY_SIZE)
+               && (obcFramBlocks[i][0] % OBCFRAM_ALIGNMENT == 0)
+               && ((i + 1 >= OBCFRAM_BLOCKS)
+                   || (obcFramBlocks[i][0] + OBCFramBlockSize(obcFramBlocks[i][1]) <= obcFramBlocks[i + 1][0]))
+               && OBCFramBlocksValid(i + 1));
+}
+
+static_assert(OBCFramBlocksValid(0), "FRAM blocks overlap, are misaligned or can't hold their container");
+static_assert(OBCFRAM_LAYOUT_END <= OBCFRAM_LOG_ADDR, "FRAM blocks overlap the telemetry history");
+static_assert(OBCFRAM_LOG_ADDR + OBCFRAM_LOG_MIN_RECORDS * OBCFRAM_LOG_RECORD_SIZE <= OBCFRAM_MIN_PART_SIZE,
+              "FRAM too small for the telemetry history");
+
+#endif /* OBCFRAMLAYOUT_H_ */
@@ -0,0 +1,240 @@
+/*
+ *  OBCFramLog.cpp
+ *
+ *  Record + 0~3        Sequence number (MSB first)
+ *  Record + 4~7        Time (MSB first)
+ *  Record + 8          Container ID
+ *  Record + 9          Size of the payload
+ *  Record + 10~        The payload
+ *  After the payload   CRC-32 of the header and the payload (4 bytes, MSB first)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "OBCFramLog.h"
+#include "OBCFramAccess.h"
+#include "Checksum.h"
+#include "BigEndian.h"
+#include <string.h>
+
+unsigned long logSlots;         // Number of records in the log region (0: no log)
+unsigned long logNextSeq;       // Sequence number of the next record
+unsigned long logCount;         // Number of records written (at most logSlots)
+unsigned char logRecord[OBCFRAM_LOG_RECORD_SIZE];
+
+/**
+ *
+ *  Please read OBCFramLog.h
+ *
+ */
+unsigned long GetLong(unsigned char *data)
+{
+    return BigEndianLoad32(data);
+}
+
+void PutLong(unsigned char *data, unsigned long ulong)
+{
+    BigEndianStore32(data, ulong);
+}
+
+/**
+ *
+ *  Read a whole record in logRecord and check it
+ *
+ */
+bool ReadRecord(MB85RS &fram, unsigned long slot)
+{
+    fram.read(OBCFRAM_LOG_ADDR + slot * OBCFRAM_LOG_RECORD_SIZE, logRecord, OBCFRAM_LOG_RECORD_SIZE);
+
+    return OBCFramLogCheckRecord(logRecord) && (GetLong(&logRecord[0]) % logSlots == slot);
+}
+
+/**
+ *
+ *  Sequence number of a record (index 0: the oldest one), its slot is sequence % logSlots
+ *
+ */
+unsigned long RecordSequence(unsigned long index)
+{
+    return logNextSeq - logCount + index;
+}
+
+void OBCFramLogInit(MB85RS &fram)
+{
+    unsigned long firstRound, low, high, middle;
+
+    logSlots = 0;
+    logNextSeq = 0;
+    logCount = 0;
+
+    if ((fram.ping() == false) || (fram.getSize() <= OBCFRAM_LOG_ADDR + OBCFRAM_LOG_RECORD_SIZE))
+    {
+        return;
+    }
+    logSlots = (fram.getSize() - OBCFRAM_LOG_ADDR) / OBCFRAM_LOG_RECORD_SIZE;
+
+    if (!ReadRecord(fram, 0))
+    {
+        // Empty log, or the last record was torn in slot 0
+        if (ReadRecord(fram, logSlots - 1))
+        {
+            logNextSeq = GetLong(&logRecord[0]) + 1;
+            logCount = logSlots;
+        }
+        return;
+    }
+
+    // Slots before the head hold records of the same round as slot 0 (round: sequence / slots),
+    // the ones after the head hold the previous round or nothing
+    firstRound = GetLong(&logRecord[0]) / logSlots;
+    low = 1;
+    high = logSlots;
+    while (low < high)
+    {
+        middle = (low + high) / 2;
+        if (ReadRecord(fram, middle) && (GetLong(&logRecord[0]) / logSlots == firstRound))
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    logNextSeq = firstRound * logSlots + low;
+    logCount = (firstRound > 0) ? logSlots : low;
+}
+
+int OBCFramLogAppend(MB85RS &fram, unsigned long time, unsigned char id, unsigned char *payload, int size)
+{
+    if (logSlots == 0)
+    {
+        return FRAM_NOT_AVAILABLE;
+    }
+
+    if ((size > OBCFRAM_LOG_MAX_PAYLOAD) || (size < 0))
+    {
+        return FRAM_WRONG_SIZE;
+    }
+
+    PutLong(&logRecord[0], logNextSeq);
+    PutLong(&logRecord[4], time);
+    logRecord[8] = id;
+    logRecord[9] = size;
+    memcpy(&logRecord[OBCFRAM_LOG_HEADER_SIZE], payload, size);
+    PutLong(&logRecord[OBCFRAM_LOG_HEADER_SIZE + size],
+            ChecksumCRC32(CHECKSUM_CRC32_INIT, logRecord, OBCFRAM_LOG_HEADER_SIZE + size));
+
+    fram.write(OBCFRAM_LOG_ADDR + (logNextSeq % logSlots) * OBCFRAM_LOG_RECORD_SIZE, logRecord,
+               OBCFRAM_LOG_HEADER_SIZE + size + 4);
+
+    logNextSeq++;
+    if (logCount < logSlots)
+    {
+        logCount++;
+    }
+    return FRAM_OPERATION_SUCCESS;
+}
+
+unsigned long OBCFramLogCount()
+{
+    return logCount;
+}
+
+unsigned long OBCFramLogSeek(MB85RS &fram, unsigned long time)
+{
+    unsigned long low = 0;
+    unsigned long high = logCount;
+    unsigned long middle, sequence;
+    unsigned char header[8];
+
+    while (low < high)
+    {
+        middle = (low + high) / 2;
+        sequence = RecordSequence(middle);
+
+        // Only the header is read. A torn record can only be the oldest one: it's older than any time.
+        fram.read(OBCFRAM_LOG_ADDR + (sequence % logSlots) * OBCFRAM_LOG_RECORD_SIZE, header, 8);
+        if ((GetLong(&header[0]) != sequence) || (GetLong(&header[4]) < time))
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+int OBCFramLogRead(MB85RS &fram, unsigned long index, unsigned long *time, unsigned char *id,
+                   unsigned char *payload, int *size)
+{
+    if ((logSlots == 0) || (index >= logCount))
+    {
+        return FRAM_NOT_AVAILABLE;
+    }
+
+    if (!ReadRecord(fram, RecordSequence(index) % logSlots)
+        || (GetLong(&logRecord[0]) != RecordSequence(index)))
+    {
+        return FRAM_NOT_WRITTEN;
+    }
+
+    *time = GetLong(&logRecord[4]);
+    *id = logRecord[8];
+    *size = logRecord[9];
+    memcpy(payload, &logRecord[OBCFRAM_LOG_HEADER_SIZE], *size);
+    return FRAM_OPERATION_SUCCESS;
+}
+
+/**
+ *
+ *  Please read OBCFramLog.h
+ *
+ */
+bool OBCFramLogCheckRecord(unsigned char *record)
+{
+    int size = record[9];
+
+    if (size > OBCFRAM_LOG_MAX_PAYLOAD)
+    {
+        return false;
+    }
+
+    return ChecksumCRC32(CHECKSUM_CRC32_INIT, record, OBCFRAM_LOG_HEADER_SIZE + size)
+            == GetLong(&record[OBCFRAM_LOG_HEADER_SIZE + size]);
+}
+
+unsigned long OBCFramLogFirstSequence()
+{
+    return logNextSeq - logCount;
+}
+
+unsigned long OBCFramLogNextSequence()
+{
+    return logNextSeq;
+}
+
+int OBCFramLogReadRaw(MB85RS &fram, unsigned long sequence, int count, unsigned char *records)
+{
+    unsigned long slot, first;
+
+    if ((logSlots == 0) || (sequence - (logNextSeq - logCount) + count > logCount))
+    {
+        return FRAM_NOT_AVAILABLE;
+    }
+    slot = sequence % logSlots;
+
+    // The records up to the end of the log region, then the ones from its start
+    first = (slot + count > logSlots) ? (logSlots - slot) : count;
+    fram.read(OBCFRAM_LOG_ADDR + slot * OBCFRAM_LOG_RECORD_SIZE, records, first * OBCFRAM_LOG_RECORD_SIZE);
+    if (first < (unsigned long)count)
+    {
+        fram.read(OBCFRAM_LOG_ADDR, &records[first * OBCFRAM_LOG_RECORD_SIZE],
+                  (count - first) * OBCFRAM_LOG_RECORD_SIZE);
+    }
+    return FRAM_OPERATION_SUCCESS;
+}
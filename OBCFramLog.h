@@ -0,0 +1,151 @@
+/*
+ *  OBCFramLog.h
+ *
+ *  Telemetry history in FRAM: a circular, append-only log of fixed-size records,
+ *  from OBCFRAM_LOG_ADDR (after the blocks, see OBCFramLayout.h) to the end of the FRAM. When the log is full, the oldest
+ *  record is overwritten.
+ *
+ *  Every record carries a sequence number, so record n is always in slot
+ *  n % (number of slots). After a reset the head is found with a binary search
+ *  on the sequence numbers (about 10 reads), without scanning the log.
+ *  The records are in time order, so a time is also found with a binary search.
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef OBCFRAMLOG_H_
+#define OBCFRAMLOG_H_
+
+#include "MB85RS.h"
+#include "OBCFramLayout.h"
+
+#define OBCFRAM_LOG_HEADER_SIZE     10   // Sequence number, time, container ID and size
+#define OBCFRAM_LOG_MAX_PAYLOAD     (OBCFRAM_LOG_RECORD_SIZE - OBCFRAM_LOG_HEADER_SIZE - 4)
+
+/**
+ *
+ *  Find the head of the log, call it once before the other functions
+ *
+ *  Parameter:
+ *      MB85RS &fram                    The FRAM object
+ *
+ */
+void OBCFramLogInit(MB85RS &fram);
+
+/**
+ *
+ *  Append a record to the log (one SPI transaction)
+ *
+ *  Parameter:
+ *      MB85RS &fram                    The FRAM object
+ *      unsigned long time              Time of the record (it should never decrease,
+ *                                      e.g. the total uptime)
+ *      unsigned char id                ID of the container (e.g. its bus address,
+ *                                      TELEMETRYLOG_ID for the packed samples of TelemetryLog.h)
+ *      unsigned char *payload          The telemetry array
+ *      int size                        The size of the array (at most OBCFRAM_LOG_MAX_PAYLOAD)
+ *
+ *  Returns:
+ *      OBCFramLogAppend()              FRAM_NOT_AVAILABLE or
+ *                                      FRAM_OPERATION_SUCCESS or
+ *                                      FRAM_WRONG_SIZE
+ *
+ */
+int OBCFramLogAppend(MB85RS &fram, unsigned long time, unsigned char id, unsigned char *payload, int size);
+
+/**
+ *
+ *  Number of records in the log
+ *
+ */
+unsigned long OBCFramLogCount();
+
+/**
+ *
+ *  Sequence numbers of the oldest record and of the next record to append
+ *  (the records in between are in the log)
+ *
+ */
+unsigned long OBCFramLogFirstSequence();
+unsigned long OBCFramLogNextSequence();
+
+/**
+ *
+ *  Read consecutive records as they are stored (OBCFRAM_LOG_RECORD_SIZE bytes each),
+ *  in one SPI transaction (two when the log wraps around in between)
+ *
+ *  Parameter:
+ *      MB85RS &fram                    The FRAM object
+ *      unsigned long sequence          Sequence number of the first record
+ *      int count                       Number of records
+ *
+ *  Returns:
+ *      OBCFramLogReadRaw()             FRAM_NOT_AVAILABLE (records not in the log) or
+ *                                      FRAM_OPERATION_SUCCESS
+ *      unsigned char *records          The records (count * OBCFRAM_LOG_RECORD_SIZE bytes)
+ *
+ */
+int OBCFramLogReadRaw(MB85RS &fram, unsigned long sequence, int count, unsigned char *records);
+
+/**
+ *
+ *  Find the first record at or after a time
+ *
+ *  Parameter:
+ *      MB85RS &fram                    The FRAM object
+ *      unsigned long time              The time
+ *
+ *  Returns:
+ *      OBCFramLogSeek()                Index of the record (0: the oldest one),
+ *                                      OBCFramLogCount() if all records are older
+ *
+ */
+unsigned long OBCFramLogSeek(MB85RS &fram, unsigned long time);
+
+/**
+ *
+ *  Check a record read as it is stored (e.g. with OBCFramLogReadRaw())
+ *
+ *  Parameter:
+ *      unsigned char *record           The record
+ *
+ *  Returns:
+ *      OBCFramLogCheckRecord()         true if the CRC of the record is correct
+ *
+ */
+bool OBCFramLogCheckRecord(unsigned char *record);
+
+/**
+ *
+ *  Big-endian 32 bits value in a record (e.g. the sequence number at offset 0,
+ *  the time at offset 4)
+ *
+ */
+unsigned long GetLong(unsigned char *data);
+void PutLong(unsigned char *data, unsigned long ulong);
+
+/**
+ *
+ *  Read a record from the log. A time range is read from OBCFramLogSeek(start)
+ *  to OBCFramLogSeek(end).
+ *
+ *  Parameter:
+ *      MB85RS &fram                    The FRAM object
+ *      unsigned long index             Index of the record (0: the oldest one)
+ *
+ *  Returns:
+ *      OBCFramLogRead()                FRAM_NOT_AVAILABLE or
+ *                                      FRAM_OPERATION_SUCCESS or
+ *                                      FRAM_NOT_WRITTEN (the record is corrupted)
+ *      unsigned long *time             Time of the record
+ *      unsigned char *id               ID of the container (TELEMETRYLOG_ID: packed samples,
+ *                                      see TelemetryLog.h)
+ *      unsigned char *payload          The telemetry array (at least OBCFRAM_LOG_MAX_PAYLOAD bytes)
+ *      int *size                       The size of the array
+ *
+ */
+int OBCFramLogRead(MB85RS &fram, unsigned long index, unsigned long *time, unsigned char *id,
+                   unsigned char *payload, int *size);
+
+#endif /* OBCFRAMLOG_H_ */
@@ -38,6 +38,8 @@ void OBCTelemetryContainer::FirstBootInit()
     setCOMMSResponse(3);
     setEPSResponse(3);
     setPROPResponse(3);
+    setRetryCount(0);
+    setTimeoutCount(0);
 
     setEndOfActivation(1800); // 30 mins
 
@@ -60,432 +62,342 @@ void OBCTelemetryContainer::FirstBootInit()
 
 // The whole telemetry array
 
-int OBCTelemetryContainer::size()
+// The second part of the telemetry array (only including changeable variables)
+
+int OBCTelemetryContainer::VariablesSize()
 {
-    return OBC_CONTAINER_SIZE;
+    return OBC_VARIABLE_SIZE;
 }
 
-unsigned char* OBCTelemetryContainer::getArray()
+unsigned char* OBCTelemetryContainer::getVariablesArray()
 {
-    return &telemetry[0];
+    return &telemetry[OBC_VARIABLE_OFFSET];
 }
 
-// The second part of the telemetry array (only including changeable variables)
+// Lines changed since the last clearDirtyLines() (saved in FRAM)
 
-int OBCTelemetryContainer::VariablesSize()
+unsigned long OBCTelemetryContainer::getDirtyLines()
 {
-    return OBC_VARIABLE_SIZE;
+    return dirtyLines;
 }
 
-unsigned char* OBCTelemetryContainer::getVariablesArray()
+void OBCTelemetryContainer::clearDirtyLines()
 {
-    return &telemetry[OBC_CONTAINER_SIZE - OBC_VARIABLE_SIZE];
+    dirtyLines = 0;
 }
 
 // Telemetry (not changable)
 
 unsigned long OBCTelemetryContainer::getBootCount()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[0];
-    ((unsigned char *)&ulong)[2] = telemetry[1];
-    ((unsigned char *)&ulong)[1] = telemetry[2];
-    ((unsigned char *)&ulong)[0] = telemetry[3];
-    return ulong;
+    return BootCountField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setBootCount(unsigned long count)
 {
-    telemetry[0] = ((unsigned char *)&count)[3];
-    telemetry[1] = ((unsigned char *)&count)[2];
-    telemetry[2] = ((unsigned char *)&count)[1];
-    telemetry[3] = ((unsigned char *)&count)[0];
+    setField<BootCountField>(count);
 }
 
 unsigned long OBCTelemetryContainer::getUpTime()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[4];
-    ((unsigned char *)&ulong)[2] = telemetry[5];
-    ((unsigned char *)&ulong)[1] = telemetry[6];
-    ((unsigned char *)&ulong)[0] = telemetry[7];
-    return ulong;
+    return UpTimeField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setUpTime(unsigned long count)
 {
-    telemetry[4] = ((unsigned char *)&count)[3];
-    telemetry[5] = ((unsigned char *)&count)[2];
-    telemetry[6] = ((unsigned char *)&count)[1];
-    telemetry[7] = ((unsigned char *)&count)[0];
+    setField<UpTimeField>(count);
 }
 
 unsigned long OBCTelemetryContainer::getTotalUpTime()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[8];
-    ((unsigned char *)&ulong)[2] = telemetry[9];
-    ((unsigned char *)&ulong)[1] = telemetry[10];
-    ((unsigned char *)&ulong)[0] = telemetry[11];
-    return ulong;
+    return TotalUpTimeField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setTotalUpTime(unsigned long count)
 {
-    telemetry[8] = ((unsigned char *)&count)[3];
-    telemetry[9] = ((unsigned char *)&count)[2];
-    telemetry[10] = ((unsigned char *)&count)[1];
-    telemetry[11] = ((unsigned char *)&count)[0];
+    setField<TotalUpTimeField>(count);
 }
 
 bool OBCTelemetryContainer::getBusStatus()
 {
-    return ((telemetry[12] & 0x80) != 0);
+    return BusStatusField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setBusStatus(bool bval)
 {
-    telemetry[12] &= (~0x80);
-    telemetry[12] |= bval ? 0x80 : 0x00;
+    setField<BusStatusField>(bval);
 }
 
 bool OBCTelemetryContainer::getTMPStatus()
 {
-    return ((telemetry[12] & 0x40) != 0);
+    return TMPStatusField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setTMPStatus(bool bval)
 {
-    telemetry[12] &= (~0x40);
-    telemetry[12] |= bval ? 0x40 : 0x00;
+    setField<TMPStatusField>(bval);
 }
 
 unsigned short OBCTelemetryContainer::getBusVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[13];
-    ((unsigned char *)&ushort)[0] = telemetry[14];
-    return ushort;
+    return BusVoltageField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setBusVoltage(unsigned short battvolt)
 {
-    telemetry[13] = ((unsigned char *)&battvolt)[1];
-    telemetry[14] = ((unsigned char *)&battvolt)[0];
+    setField<BusVoltageField>(battvolt);
 }
 
 signed short OBCTelemetryContainer::getBusCurrent()
 {
-    signed short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[15];
-    ((unsigned char *)&ushort)[0] = telemetry[16];
-    return ushort;
+    return BusCurrentField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setBusCurrent(signed short current)
 {
-    telemetry[15] = ((unsigned char *)&current)[1];
-    telemetry[16] = ((unsigned char *)&current)[0];
+    setField<BusCurrentField>(current);
 }
 
 signed short OBCTelemetryContainer::getTemperature()
 {
-    signed short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[17];
-    ((unsigned char *)&ushort)[0] = telemetry[18];
-    return ushort;
+    return TemperatureField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setTemperature(signed short temp)
 {
-    telemetry[17] = ((unsigned char *)&temp)[1];
-    telemetry[18] = ((unsigned char *)&temp)[0];
+    setField<TemperatureField>(temp);
 }
 
 unsigned char OBCTelemetryContainer::getADBResponse()
 {
-    return telemetry[19];
+    return ADBResponseField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setADBResponse(unsigned char res)
 {
-    telemetry[19] = res;
+    setField<ADBResponseField>(res);
 }
 
 unsigned char OBCTelemetryContainer::getADCSResponse()
 {
-    return telemetry[20];
+    return ADCSResponseField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setADCSResponse(unsigned char res)
 {
-    telemetry[20] = res;
+    setField<ADCSResponseField>(res);
 }
 
 unsigned char OBCTelemetryContainer::getCOMMSResponse()
 {
-    return telemetry[21];
+    return COMMSResponseField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setCOMMSResponse(unsigned char res)
 {
-    telemetry[21] = res;
+    setField<COMMSResponseField>(res);
 }
 
 unsigned char OBCTelemetryContainer::getEPSResponse()
 {
-    return telemetry[22];
+    return EPSResponseField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setEPSResponse(unsigned char res)
 {
-    telemetry[22] = res;
+    setField<EPSResponseField>(res);
 }
 
 unsigned char OBCTelemetryContainer::getPROPResponse()
 {
-    return telemetry[23];
+    return PROPResponseField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setPROPResponse(unsigned char res)
 {
-    telemetry[23] = res;
+    setField<PROPResponseField>(res);
 }
 
 // Variables in every mode
 
 Mode OBCTelemetryContainer::getMode()
 {
-    return (Mode)telemetry[24];
+    return ModeField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setMode(Mode currentMode)
 {
-    telemetry[24] = (unsigned char)currentMode;
+    setField<ModeField>(currentMode);
 }
 
 // Variables in the activation mode
 
 unsigned long OBCTelemetryContainer::getEndOfActivation()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[25];
-    ((unsigned char *)&ulong)[2] = telemetry[26];
-    ((unsigned char *)&ulong)[1] = telemetry[27];
-    ((unsigned char *)&ulong)[0] = telemetry[28];
-    return ulong;
+    return EndOfActivationField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setEndOfActivation(unsigned long uplong)
 {
-    telemetry[25] = ((unsigned char *)&uplong)[3];
-    telemetry[26] = ((unsigned char *)&uplong)[2];
-    telemetry[27] = ((unsigned char *)&uplong)[1];
-    telemetry[28] = ((unsigned char *)&uplong)[0];
+    setField<EndOfActivationField>(uplong);
 }
 
 // Variables in the deployment mode
 
 DeployState OBCTelemetryContainer::getDeployState()
 {
-    return (DeployState)telemetry[29];
+    return DeployStateField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setDeployState(DeployState state)
 {
-    telemetry[29] = (unsigned char)state;
+    setField<DeployStateField>(state);
 }
 
 unsigned long OBCTelemetryContainer::getEndOfDeployState()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[30];
-    ((unsigned char *)&ulong)[2] = telemetry[31];
-    ((unsigned char *)&ulong)[1] = telemetry[32];
-    ((unsigned char *)&ulong)[0] = telemetry[33];
-    return ulong;
+    return EndOfDeployStateField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setEndOfDeployState(unsigned long uplong)
 {
-    telemetry[30] = ((unsigned char *)&uplong)[3];
-    telemetry[31] = ((unsigned char *)&uplong)[2];
-    telemetry[32] = ((unsigned char *)&uplong)[1];
-    telemetry[33] = ((unsigned char *)&uplong)[0];
+    setField<EndOfDeployStateField>(uplong);
 }
 
 unsigned short OBCTelemetryContainer::getDeployVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[34];
-    ((unsigned char *)&ushort)[0] = telemetry[35];
-    return ushort;
+    return DeployVoltageField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setDeployVoltage(unsigned short deployvolt)
 {
-    telemetry[34] = ((unsigned char *)&deployvolt)[1];
-    telemetry[35] = ((unsigned char *)&deployvolt)[0];
+    setField<DeployVoltageField>(deployvolt);
 }
 
 unsigned long OBCTelemetryContainer::getForcedDeployPeriod()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[36];
-    ((unsigned char *)&ulong)[2] = telemetry[37];
-    ((unsigned char *)&ulong)[1] = telemetry[38];
-    ((unsigned char *)&ulong)[0] = telemetry[39];
-    return ulong;
+    return ForcedDeployPeriodField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setForcedDeployPeriod(unsigned long uplong)
 {
-    telemetry[36] = ((unsigned char *)&uplong)[3];
-    telemetry[37] = ((unsigned char *)&uplong)[2];
-    telemetry[38] = ((unsigned char *)&uplong)[1];
-    telemetry[39] = ((unsigned char *)&uplong)[0];
+    setField<ForcedDeployPeriodField>(uplong);
 }
 
 unsigned long OBCTelemetryContainer::getDelayingDeployPeriod()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[40];
-    ((unsigned char *)&ulong)[2] = telemetry[41];
-    ((unsigned char *)&ulong)[1] = telemetry[42];
-    ((unsigned char *)&ulong)[0] = telemetry[43];
-    return ulong;
+    return DelayingDeployPeriodField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setDelayingDeployPeriod(unsigned long uplong)
 {
-    telemetry[40] = ((unsigned char *)&uplong)[3];
-    telemetry[41] = ((unsigned char *)&uplong)[2];
-    telemetry[42] = ((unsigned char *)&uplong)[1];
-    telemetry[43] = ((unsigned char *)&uplong)[0];
+    setField<DelayingDeployPeriodField>(uplong);
 }
 
 // Variables in the safe mode
 
 unsigned short OBCTelemetryContainer::getSMVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[45];
-    ((unsigned char *)&ushort)[0] = telemetry[46];
-    return ushort;
+    return SMVoltageField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setSMVoltage(unsigned short safevoltage)
 {
-    telemetry[45] = ((unsigned char *)&safevoltage)[1];
-    telemetry[46] = ((unsigned char *)&safevoltage)[0];
+    setField<SMVoltageField>(safevoltage);
 }
 
 // Variables in the ADCS mode
 
 ADCSState OBCTelemetryContainer::getADCSState()
 {
-    return (ADCSState)telemetry[47];
+    return ADCSStateField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setADCSState(ADCSState state)
 {
-    telemetry[47] = (unsigned char)state;
+    setField<ADCSStateField>(state);
 }
 
 unsigned long OBCTelemetryContainer::getEndOfADCSState()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[48];
-    ((unsigned char *)&ulong)[2] = telemetry[49];
-    ((unsigned char *)&ulong)[1] = telemetry[50];
-    ((unsigned char *)&ulong)[0] = telemetry[51];
-    return ulong;
+    return EndOfADCSStateField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setEndOfADCSState(unsigned long uplong)
 {
-    telemetry[48] = ((unsigned char *)&uplong)[3];
-    telemetry[49] = ((unsigned char *)&uplong)[2];
-    telemetry[50] = ((unsigned char *)&uplong)[1];
-    telemetry[51] = ((unsigned char *)&uplong)[0];
+    setField<EndOfADCSStateField>(uplong);
 }
 
 unsigned short OBCTelemetryContainer::getRotateSpeedLimit()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[52];
-    ((unsigned char *)&ushort)[0] = telemetry[53];
-    return ushort;
+    return RotateSpeedLimitField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setRotateSpeedLimit(unsigned short value)
 {
-    telemetry[52] = ((unsigned char *)&value)[1];
-    telemetry[53] = ((unsigned char *)&value)[0];
+    setField<RotateSpeedLimitField>(value);
 }
 
 
 unsigned long OBCTelemetryContainer::getDetumblingPeriod()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[54];
-    ((unsigned char *)&ulong)[2] = telemetry[55];
-    ((unsigned char *)&ulong)[1] = telemetry[56];
-    ((unsigned char *)&ulong)[0] = telemetry[57];
-    return ulong;
+    return DetumblingPeriodField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setDetumblingPeriod(unsigned long uplong)
 {
-    telemetry[54] = ((unsigned char *)&uplong)[3];
-    telemetry[55] = ((unsigned char *)&uplong)[2];
-    telemetry[56] = ((unsigned char *)&uplong)[1];
-    telemetry[57] = ((unsigned char *)&uplong)[0];
+    setField<DetumblingPeriodField>(uplong);
 }
 
 PowerState OBCTelemetryContainer::getADCSPowerState()
 {
-    return (PowerState)telemetry[58];
+    return ADCSPowerStateField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setADCSPowerState(PowerState state)
 {
-    telemetry[58] = (unsigned char)state;
+    setField<ADCSPowerStateField>(state);
 }
 
 
 unsigned long OBCTelemetryContainer::getEndOfADCSPowerState()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[59];
-    ((unsigned char *)&ulong)[2] = telemetry[60];
-    ((unsigned char *)&ulong)[1] = telemetry[61];
-    ((unsigned char *)&ulong)[0] = telemetry[62];
-    return ulong;
+    return EndOfADCSPowerStateField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setEndOfADCSPowerState(unsigned long uplong)
 {
-    telemetry[59] = ((unsigned char *)&uplong)[3];
-    telemetry[60] = ((unsigned char *)&uplong)[2];
-    telemetry[61] = ((unsigned char *)&uplong)[1];
-    telemetry[62] = ((unsigned char *)&uplong)[0];
+    setField<EndOfADCSPowerStateField>(uplong);
 }
 
 unsigned long OBCTelemetryContainer::getADCSPowerCyclePeriod()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[63];
-    ((unsigned char *)&ulong)[2] = telemetry[64];
-    ((unsigned char *)&ulong)[1] = telemetry[65];
-    ((unsigned char *)&ulong)[0] = telemetry[66];
-    return ulong;
+    return ADCSPowerCyclePeriodField::get(telemetry);
 }
 
 void OBCTelemetryContainer::setADCSPowerCyclePeriod(unsigned long uplong)
 {
-    telemetry[63] = ((unsigned char *)&uplong)[3];
-    telemetry[64] = ((unsigned char *)&uplong)[2];
-    telemetry[65] = ((unsigned char *)&uplong)[1];
-    telemetry[66] = ((unsigned char *)&uplong)[0];
+    setField<ADCSPowerCyclePeriodField>(uplong);
+}
+
+// Counters of the bus (saturated at 65535)
+
+unsigned short OBCTelemetryContainer::getRetryCount()
+{
+    return RetryCountField::get(telemetry);
+}
+
+void OBCTelemetryContainer::setRetryCount(unsigned long count)
+{
+    setField<RetryCountField>((count < 0xFFFF) ? count : 0xFFFF);
+}
+
+unsigned short OBCTelemetryContainer::getTimeoutCount()
+{
+    return TimeoutCountField::get(telemetry);
+}
+
+void OBCTelemetryContainer::setTimeoutCount(unsigned long count)
+{
+    setField<TimeoutCountField>((count < 0xFFFF) ? count : 0xFFFF);
 }
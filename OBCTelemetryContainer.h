@@ -9,9 +9,13 @@
 #define OBCTELEMETRYCONTAINER_H_
 
 #include "TelemetryContainer.h"
+#include "TelemetryField.h"
+#include "DirtyLines.h"
+#include <string.h>
 
-#define OBC_CONTAINER_SIZE  67
+#define OBC_CONTAINER_SIZE  71
 #define OBC_VARIABLE_SIZE      43
+#define OBC_VARIABLE_OFFSET    24
 
 typedef enum Mode {ACTIVATIONMODE, DEPLOYMENTMODE, SAFEMODE, ADCSMODE, NOMINALMODE} Mode;
 
@@ -34,9 +38,59 @@ class OBCTelemetryContainer : public TelemetryContainer
 {
 protected:
     unsigned char telemetry[OBC_CONTAINER_SIZE];
+    unsigned long dirtyLines; // Lines changed by the setters, see DirtyLines.h
+
+    // Set a field, its lines are dirty only when its bytes change: StateMachine()
+    // calls most setters every tick with the same value
+    template <typename Field, typename T>
+    void setField(T value)
+    {
+        unsigned char previous[Field::width];
+
+        memcpy(previous, &telemetry[Field::offset], Field::width);
+        Field::set(telemetry, value);
+        if (memcmp(previous, &telemetry[Field::offset], Field::width) != 0)
+        {
+            dirtyLines |= DirtyLinesOf(Field::offset, Field::width);
+        }
+    }
 
 public:
 
+    // Fields of the telemetry array (see TelemetryField.h)
+    typedef TelemetryField<unsigned long, 0, 4> BootCountField;
+    typedef TelemetryField<unsigned long, 4, 4> UpTimeField;
+    typedef TelemetryField<unsigned long, 8, 4> TotalUpTimeField;
+    typedef TelemetryFlag<12, 0x40> TMPStatusField;
+    typedef TelemetryFlag<12, 0x80> BusStatusField;
+    typedef TelemetryField<unsigned short, 13, 2> BusVoltageField;
+    typedef TelemetryField<signed short, 15, 2> BusCurrentField;
+    typedef TelemetryField<signed short, 17, 2> TemperatureField;
+    typedef TelemetryField<unsigned char, 19, 1> ADBResponseField;
+    typedef TelemetryField<unsigned char, 20, 1> ADCSResponseField;
+    typedef TelemetryField<unsigned char, 21, 1> COMMSResponseField;
+    typedef TelemetryField<unsigned char, 22, 1> EPSResponseField;
+    typedef TelemetryField<unsigned char, 23, 1> PROPResponseField;
+    typedef TelemetryField<Mode, 24, 1> ModeField;
+    typedef TelemetryField<unsigned long, 25, 4> EndOfActivationField;
+    typedef TelemetryField<DeployState, 29, 1> DeployStateField;
+    typedef TelemetryField<unsigned long, 30, 4> EndOfDeployStateField;
+    typedef TelemetryField<unsigned short, 34, 2> DeployVoltageField;
+    typedef TelemetryField<unsigned long, 36, 4> ForcedDeployPeriodField;
+    typedef TelemetryField<unsigned long, 40, 4> DelayingDeployPeriodField;
+    typedef TelemetryField<unsigned short, 45, 2> SMVoltageField;
+    typedef TelemetryField<ADCSState, 47, 1> ADCSStateField;
+    typedef TelemetryField<unsigned long, 48, 4> EndOfADCSStateField;
+    typedef TelemetryField<unsigned short, 52, 2> RotateSpeedLimitField;
+    typedef TelemetryField<unsigned long, 54, 4> DetumblingPeriodField;
+    typedef TelemetryField<PowerState, 58, 1> ADCSPowerStateField;
+    typedef TelemetryField<unsigned long, 59, 4> EndOfADCSPowerStateField;
+    typedef TelemetryField<unsigned long, 63, 4> ADCSPowerCyclePeriodField;
+
+    // Appended after the variables, so the older fields keep their offsets
+    typedef TelemetryField<unsigned short, 67, 2> RetryCountField;
+    typedef TelemetryField<unsigned short, 69, 2> TimeoutCountField;
+
     // Initialization functions
 
     void NormalInit();
@@ -44,14 +98,19 @@ public:
 
     // The whole telemetry array
 
-    int size();
-    unsigned char * getArray();
+    int size() { return OBC_CONTAINER_SIZE; }
+    unsigned char * getArray() { return telemetry; }
 
     // The second part of the telemetry array (only including changeable variables)
 
     int VariablesSize();
     unsigned char * getVariablesArray();
 
+    // Lines changed since the last clearDirtyLines() (saved in FRAM)
+
+    unsigned long getDirtyLines();
+    void clearDirtyLines();
+
     // Telemetry (not changable)
 
     unsigned long getBootCount();
@@ -147,6 +206,14 @@ public:
 
     unsigned long getADCSPowerCyclePeriod();
     void setADCSPowerCyclePeriod(unsigned long uplong);
+
+    // Counters of the bus (saturated at 65535)
+
+    unsigned short getRetryCount(); // Retries on the PQ9 bus since boot
+    void setRetryCount(unsigned long count);
+
+    unsigned short getTimeoutCount(); // Requests without reply since boot
+    void setTimeoutCount(unsigned long count);
 };
 
 #endif /* OBCTELEMETRYCONTAINER_H_ */
@@ -7,212 +7,152 @@
 
 #include "PROPTelemetryContainer.h"
 
-int PROPTelemetryContainer::size()
-{
-    return PROP_CONTAINER_SIZE;
-}
-
-unsigned char* PROPTelemetryContainer::getArray()
-{
-    return &telemetry[0];
-}
-
 unsigned long PROPTelemetryContainer::getUpTime()
 {
-    unsigned long ulong;
-    ((unsigned char *)&ulong)[3] = telemetry[0];
-    ((unsigned char *)&ulong)[2] = telemetry[1];
-    ((unsigned char *)&ulong)[1] = telemetry[2];
-    ((unsigned char *)&ulong)[0] = telemetry[3];
-    return ulong;
+    return UpTimeField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setUpTime(unsigned long ulong)
 {
-    *((unsigned long *)&(telemetry[0])) = ulong;
-    telemetry[0] = ((unsigned char *)&ulong)[3];
-    telemetry[1] = ((unsigned char *)&ulong)[2];
-    telemetry[2] = ((unsigned char *)&ulong)[1];
-    telemetry[3] = ((unsigned char *)&ulong)[0];
+    UpTimeField::set(telemetry, ulong);
 }
 
 bool PROPTelemetryContainer::getBusStatus()
 {
-    return ((telemetry[7] & 0x02) != 0);
+    return BusStatusField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setBusStatus(bool bval)
 {
-    telemetry[7] &= (~0x02);
-    telemetry[7] |= bval ? 0x02 : 0x00;
+    BusStatusField::set(telemetry, bval);
 }
 
 bool PROPTelemetryContainer::getValveHoldStatus()
 {
-    return ((telemetry[7] & 0x04) != 0);
+    return ValveHoldStatusField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setValveHoldStatus(bool bval)
 {
-    telemetry[7] &= (~0x04);
-    telemetry[7] |= bval ? 0x04 : 0x00;
+    ValveHoldStatusField::set(telemetry, bval);
 }
 
 bool PROPTelemetryContainer::getValveSpikeStatus()
 {
-    return ((telemetry[7] & 0x08) != 0);
+    return ValveSpikeStatusField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setValveSpikeStatus(bool bval)
 {
-    telemetry[7] &= (~0x08);
-    telemetry[7] |= bval ? 0x08 : 0x00;
+    ValveSpikeStatusField::set(telemetry, bval);
 }
 
 bool PROPTelemetryContainer::getHeatersStatus()
 {
-    return ((telemetry[7] & 0x10) != 0);
+    return HeatersStatusField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setHeatersStatus(bool bval)
 {
-    telemetry[7] &= (~0x10);
-    telemetry[7] |= bval ? 0x10 : 0x00;
+    HeatersStatusField::set(telemetry, bval);
 }
 
 bool PROPTelemetryContainer::getTmpStatus()
 {
-    return ((telemetry[7] & 0x01) != 0);
+    return TmpStatusField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setTmpStatus(bool bval)
 {
-    telemetry[7] &= (~0x01);
-    telemetry[7] |= bval ? 0x01 : 0x00;
+    TmpStatusField::set(telemetry, bval);
 }
 
 signed short PROPTelemetryContainer::getBusCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[16];
-    ((unsigned char *)&ushort)[0] = telemetry[17];
-    return ushort;
+    return BusCurrentField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setBusCurrent(signed short ushort)
 {
-    telemetry[16] = ((unsigned char *)&ushort)[1];
-    telemetry[17] = ((unsigned char *)&ushort)[0];
+    BusCurrentField::set(telemetry, ushort);
 }
 
 unsigned short PROPTelemetryContainer::getBusVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[24];
-    ((unsigned char *)&ushort)[0] = telemetry[25];
-    return ushort;
+    return BusVoltageField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setBusVoltage(unsigned short ushort)
 {
-    telemetry[24] = ((unsigned char *)&ushort)[1];
-    telemetry[25] = ((unsigned char *)&ushort)[0];
+    BusVoltageField::set(telemetry, ushort);
 }
 
 signed short PROPTelemetryContainer::getValveHoldCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[14];
-    ((unsigned char *)&ushort)[0] = telemetry[15];
-    return ushort;
+    return ValveHoldCurrentField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setValveHoldCurrent(signed short ushort)
 {
-    telemetry[14] = ((unsigned char *)&ushort)[1];
-    telemetry[15] = ((unsigned char *)&ushort)[0];
+    ValveHoldCurrentField::set(telemetry, ushort);
 }
 
 unsigned short PROPTelemetryContainer::getValveHoldVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[22];
-    ((unsigned char *)&ushort)[0] = telemetry[23];
-    return ushort;
+    return ValveHoldVoltageField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setValveHoldVoltage(unsigned short ushort)
 {
-    telemetry[22] = ((unsigned char *)&ushort)[1];
-    telemetry[23] = ((unsigned char *)&ushort)[0];
+    ValveHoldVoltageField::set(telemetry, ushort);
 }
 
 signed short PROPTelemetryContainer::getValveSpikeCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[12];
-    ((unsigned char *)&ushort)[0] = telemetry[13];
-    return ushort;
+    return ValveSpikeCurrentField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setValveSpikeCurrent(signed short ushort)
 {
-    telemetry[12] = ((unsigned char *)&ushort)[1];
-    telemetry[13] = ((unsigned char *)&ushort)[0];
+    ValveSpikeCurrentField::set(telemetry, ushort);
 }
 
 unsigned short PROPTelemetryContainer::getValveSpikeVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[20];
-    ((unsigned char *)&ushort)[0] = telemetry[21];
-    return ushort;
+    return ValveSpikeVoltageField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setValveSpikeVoltage(unsigned short ushort)
 {
-    telemetry[20] = ((unsigned char *)&ushort)[1];
-    telemetry[21] = ((unsigned char *)&ushort)[0];
+    ValveSpikeVoltageField::set(telemetry, ushort);
 }
 
 signed short PROPTelemetryContainer::getHeatersCurrent()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[16];
-    ((unsigned char *)&ushort)[0] = telemetry[17];
-    return ushort;
+    return HeatersCurrentField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setHeatersCurrent(signed short ushort)
 {
-    telemetry[10] = ((unsigned char *)&ushort)[1];
-    telemetry[11] = ((unsigned char *)&ushort)[0];
+    HeatersCurrentField::set(telemetry, ushort);
 }
 
 unsigned short PROPTelemetryContainer::getHeatersVoltage()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[18];
-    ((unsigned char *)&ushort)[0] = telemetry[19];
-    return ushort;
+    return HeatersVoltageField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setHeatersVoltage(unsigned short ushort)
 {
-    telemetry[18] = ((unsigned char *)&ushort)[1];
-    telemetry[19] = ((unsigned char *)&ushort)[0];
+    HeatersVoltageField::set(telemetry, ushort);
 }
 
 signed short PROPTelemetryContainer::getTemperature()
 {
-    unsigned short ushort;
-    ((unsigned char *)&ushort)[1] = telemetry[8];
-    ((unsigned char *)&ushort)[0] = telemetry[9];
-    return ushort;
+    return TemperatureField::get(telemetry);
 }
 
 void PROPTelemetryContainer::setTemperature(signed short ushort)
 {
-    telemetry[8] = ((unsigned char *)&ushort)[1];
-    telemetry[9] = ((unsigned char *)&ushort)[0];
+    TemperatureField::set(telemetry, ushort);
 }
@@ -9,6 +9,7 @@
 #define PROPTELEMETRYCONTAINER_H_
 
 #include "TelemetryContainer.h"
+#include "TelemetryField.h"
 
 #define PROP_CONTAINER_SIZE  26
 
@@ -18,8 +19,26 @@ protected:
     unsigned char telemetry[PROP_CONTAINER_SIZE];
 
 public:
-    virtual int size();
-    virtual unsigned char * getArray();
+    // Fields of the telemetry array (see TelemetryField.h)
+    typedef TelemetryField<unsigned long, 0, 4> UpTimeField;
+    typedef TelemetryFlag<7, 0x01> TmpStatusField;
+    typedef TelemetryFlag<7, 0x02> BusStatusField;
+    typedef TelemetryFlag<7, 0x04> ValveHoldStatusField;
+    typedef TelemetryFlag<7, 0x08> ValveSpikeStatusField;
+    typedef TelemetryFlag<7, 0x10> HeatersStatusField;
+    typedef TelemetryField<signed short, 8, 2> TemperatureField;
+    typedef TelemetryField<signed short, 10, 2> HeatersCurrentField;
+    typedef TelemetryField<signed short, 12, 2> ValveSpikeCurrentField;
+    typedef TelemetryField<signed short, 14, 2> ValveHoldCurrentField;
+    typedef TelemetryField<signed short, 16, 2> BusCurrentField;
+    typedef TelemetryField<unsigned short, 18, 2> HeatersVoltageField;
+    typedef TelemetryField<unsigned short, 20, 2> ValveSpikeVoltageField;
+    typedef TelemetryField<unsigned short, 22, 2> ValveHoldVoltageField;
+    typedef TelemetryField<unsigned short, 24, 2> BusVoltageField;
+
+    // The telemetry array and its size
+    virtual int size() { return PROP_CONTAINER_SIZE; }
+    virtual unsigned char * getArray() { return telemetry; }
 
     unsigned long getUpTime();
     void setUpTime(unsigned long ulong);
@@ -5,59 +5,275 @@
  *      Author: Johan Monster
  *
  *  Generalizes control over EPS power lines.
+ *
+ *  Each line is set with its own frame:
+ *      payload[0]  Power bus service (0x01)
+ *      payload[1]  Request (0x01)
+ *      payload[2]  Line number (0x01: V1 ~ 0x04: V4)
+ *      payload[3]  State (0x00: off, 0x01: on)
+ *
+ *  This differs from the first version of this file, which sent
+ *  {state, 0x01, line, 0x01}: the state was in byte [0] and byte [3] was a
+ *  constant "execute" (and the payloads aliased, so every frame carried line 4).
+ *  Byte [0] of a PQ9 payload is the service number and byte [1] the request
+ *  type: RequestReply() matches the reply on payload[0] (SERVICE_RESPONSE_* in
+ *  Communication.h), so an "off" frame of the old layout was addressed to
+ *  service 0. The layout above is the one of the EPS power bus service (service
+ *  0x01, line then state). The EPS software isn't in this repository, so check
+ *  it against the EPS power bus service before flight.
+ *
+ *  Only the lines whose state differs from the one confirmed by EPS are sent.
+ *  The state of the lines confirmed by EPS comes from the acknowledgement of
+ *  the commands and from the EPS telemetry (B1 ~ B4 status) of every tick.
  */
 
+#include "PowerBusControl.h"
 #include "Communication.h"
 
-bool PowerBusControl(bool Line1, bool Line2, bool Line3, bool Line4) {
+#define POWER_BUS_SERVICE   0x01
+#define POWER_LINE_COUNT    4
 
-    // Define relevant hex values corresponding to EPS command over bus.
-    bool fault = true;
-    char execute = 0x01;
-    char request = 0x01;
-    char V1 = 0x01;
-    char V2 = 0x02;
-    char V3 = 0x03;
-    char V4 = 0x04;
-    char stateon = 0x01;
-    char stateoff = 0x00;
+// Last line mask commanded by OBC and last line mask confirmed by EPS
+// (POWER_MASK_UNKNOWN after boot or a fault)
+unsigned char commandedMask = POWER_MASK_UNKNOWN;
+unsigned char confirmedMask = POWER_MASK_UNKNOWN;
 
-    // char to store received command
-    unsigned char* Reply;
-    unsigned char ReplySize;
+// The lines are commanded again when the state is older than the refresh period
+unsigned long refreshPeriod = POWER_DEFAULT_REFRESH_PERIOD;
+unsigned long ticksSinceCommand;
+
+unsigned long commandsSent;
+unsigned long commandsSkipped;
+unsigned long mismatchesCorrected;
+
+// Line commands sent in the background by PowerBusControlAsync()
+RequestHandle asyncHandle = INVALID_REQUEST_HANDLE;
+unsigned char asyncMask;
+unsigned char asyncLines;       // Lines which are not sent yet
+
+/**
+ *
+ *  Lines which have to be commanded to set a mask (0 if EPS already has this state).
+ *  It also updates the commanded mask and the counters.
+ *
+ */
+unsigned char LinesToCommand(unsigned char mask)
+{
+    unsigned char changed;
+
+    // EPS reports another state than what was commanded before (e.g. after a reset of EPS),
+    // a legitimate change of the commanded state is not a mismatch
+    if ((commandedMask != POWER_MASK_UNKNOWN) && (confirmedMask != POWER_MASK_UNKNOWN)
+            && (confirmedMask != commandedMask) && (mask != confirmedMask))
+    {
+        mismatchesCorrected++;
+    }
+    commandedMask = mask;
+
+    // Nothing to do if EPS already confirmed this state
+    if ((mask == confirmedMask) && (ticksSinceCommand < refreshPeriod))
+    {
+        commandsSkipped++;
+        return 0;
+    }
+
+    // Command every line when the state is unknown or older than the refresh period
+    if ((confirmedMask == POWER_MASK_UNKNOWN) || (ticksSinceCommand >= refreshPeriod))
+    {
+        changed = POWER_MASK_ALL;
+    }
+    else
+    {
+        changed = mask ^ confirmedMask;
+    }
+    ticksSinceCommand = 0;
+    return changed;
+}
 
-    // Define structure of first payload.
-    unsigned char payload1[4];
-    payload1[0] = stateon;
-    payload1[1] = request;
-    payload1[2] = V1;
-    payload1[3] = execute;
+/**
+ *
+ *  Prepare the frame of one line
+ *
+ */
+void PrepareLinePayload(unsigned char *payload, unsigned char mask, int line)
+{
+    payload[0] = POWER_BUS_SERVICE;
+    payload[1] = SERVICE_RESPONSE_REQUEST;
+    payload[2] = line + 1;
+    payload[3] = (mask >> line) & 0x01;
+}
 
-    // Define other payloads.
-    // The default state is [1, 0, 0, 0]
-    unsigned char* payload2 = payload1;
-    payload2[0] = stateoff;
-    payload2[2] = V2;
+/**
+ *
+ *  Wait until the line commands of PowerBusControlAsync() are completed
+ *
+ */
+void PowerBusWait()
+{
+    // The callback of every command sends the next line
+    while (asyncHandle != INVALID_REQUEST_HANDLE)
+    {
+        RequestWait(asyncHandle);
+    }
+}
 
-    unsigned char* payload3 = payload2;
-    payload3[2] = V3;
+bool PowerBusControlMask(unsigned char mask)
+{
+    // char to store received command
+    unsigned char Reply[4];
+    unsigned int ReplySize;
+    unsigned char payload[4];
+    unsigned char changed;
 
-    unsigned char* payload4 = payload2;
-    payload4[2] = V4;
+    mask &= POWER_MASK_ALL;
 
-    if (Line1 == 0) {payload1[0] = stateoff;}
-    if (Line2 == 1) {payload2[0] = stateon;}
-    if (Line3 == 1) {payload3[0] = stateon;}
-    if (Line4 == 1) {payload4[0] = stateon;}
+    // Only one command to the power bus service of EPS can be pending
+    PowerBusWait();
+
+    changed = LinesToCommand(mask);
 
     //Send to EPS
-    char Success1 = RequestReply(EPS, 4, payload1, &ReplySize, &Reply, 500);
-    char Success2 = RequestReply(EPS, 4, payload2, &ReplySize, &Reply, 500);
-    char Success3 = RequestReply(EPS, 4, payload3, &ReplySize, &Reply, 500);
-    char Success4 = RequestReply(EPS, 4, payload4, &ReplySize, &Reply, 500);
+    for (int line = 0; line < POWER_LINE_COUNT; line++)
+    {
+        if ((changed & (1 << line)) == 0)
+        {
+            continue;
+        }
 
-    if (Success1 ==2 && Success2 ==2 && Success3 ==2 && Success4 ==2) {
-        fault = false;
+        PrepareLinePayload(payload, mask, line);
+        commandsSent++;
+        ReplySize = sizeof(Reply);
+        if (RequestReplyRetry(POWER_REQUEST, EPS, 4, payload, &ReplySize, Reply, 500) != SERVICE_RESPONSE_REPLY)
+        {
+            // The state of the lines is unknown, command them again next time
+            confirmedMask = POWER_MASK_UNKNOWN;
+            return true;
+        }
     }
-    return fault;
+
+    confirmedMask = mask;
+    return false;
+}
+
+/**
+ *
+ *  Send the next line of PowerBusControlAsync(), called again when its reply arrives
+ *
+ */
+void PowerBusAsyncCompleted(RequestHandle handle, char status, DataFrame *reply);
+
+void PowerBusAsyncNext()
+{
+    unsigned char payload[4];
+    int line = 0;
+
+    if (asyncLines == 0)
+    {
+        confirmedMask = asyncMask;
+        asyncHandle = INVALID_REQUEST_HANDLE;
+        return;
+    }
+
+    while ((asyncLines & (1 << line)) == 0)
+    {
+        line++;
+    }
+    asyncLines &= ~(1 << line);
+
+    PrepareLinePayload(payload, asyncMask, line);
+    commandsSent++;
+    asyncHandle = RequestReplyAsync(POWER_REQUEST, EPS, 4, payload, 500, PowerBusAsyncCompleted);
+    if (asyncHandle == INVALID_REQUEST_HANDLE)
+    {
+        confirmedMask = POWER_MASK_UNKNOWN;
+    }
+}
+
+void PowerBusAsyncCompleted(RequestHandle, char status, DataFrame *)
+{
+    if (status != SERVICE_RESPONSE_REPLY)
+    {
+        // The state of the lines is unknown, PowerBusControlMask() commands them again
+        confirmedMask = POWER_MASK_UNKNOWN;
+        asyncHandle = INVALID_REQUEST_HANDLE;
+        return;
+    }
+    PowerBusAsyncNext();
+}
+
+bool PowerBusControlAsync(unsigned char mask)
+{
+    // The previous lines are still being sent
+    if (asyncHandle != INVALID_REQUEST_HANDLE)
+    {
+        return true;
+    }
+
+    asyncMask = mask & POWER_MASK_ALL;
+    asyncLines = LinesToCommand(asyncMask);
+    if (asyncLines == 0)
+    {
+        return false;
+    }
+
+    PowerBusAsyncNext();
+    return (asyncHandle == INVALID_REQUEST_HANDLE);
+}
+
+bool PowerBusControl(bool Line1, bool Line2, bool Line3, bool Line4) {
+
+    unsigned char mask = 0;
+
+    if (Line1) {mask |= POWER_LINE_V1;}
+    if (Line2) {mask |= POWER_LINE_V2;}
+    if (Line3) {mask |= POWER_LINE_V3;}
+    if (Line4) {mask |= POWER_LINE_V4;}
+
+    return PowerBusControlMask(mask);
+}
+
+void PowerBusTelemetry(EPSTelemetryContainer *EPSContainer, bool valid)
+{
+    ticksSinceCommand++;
+
+    if (!valid)
+    {
+        return;
+    }
+
+    confirmedMask = 0;
+    if (EPSContainer->getB1Status()) {confirmedMask |= POWER_LINE_V1;}
+    if (EPSContainer->getB2Status()) {confirmedMask |= POWER_LINE_V2;}
+    if (EPSContainer->getB3Status()) {confirmedMask |= POWER_LINE_V3;}
+    if (EPSContainer->getB4Status()) {confirmedMask |= POWER_LINE_V4;}
+}
+
+void PowerBusSetRefreshPeriod(unsigned long ticks)
+{
+    refreshPeriod = ticks;
+}
+
+unsigned char PowerBusCommandedMask()
+{
+    return commandedMask;
+}
+
+unsigned char PowerBusConfirmedMask()
+{
+    return confirmedMask;
+}
+
+unsigned long PowerBusCommandsSent()
+{
+    return commandsSent;
+}
+
+unsigned long PowerBusCommandsSkipped()
+{
+    return commandsSkipped;
+}
+
+unsigned long PowerBusMismatchesCorrected()
+{
+    return mismatchesCorrected;
 }
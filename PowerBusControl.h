@@ -12,12 +12,28 @@
 #ifndef POWERBUSCONTROL_H_
 #define POWERBUSCONTROL_H_
 
+#include "EPSTelemetryContainer.h"
+
+// Power lines in a line mask
+#define POWER_LINE_V1       0x01
+#define POWER_LINE_V2       0x02
+#define POWER_LINE_V3       0x04
+#define POWER_LINE_V4       0x08
+#define POWER_MASK_ALL      0x0F
+#define POWER_MASK_UNKNOWN  0xFF
+
+// Number of ticks after which an unchanged state is commanded again
+#define POWER_DEFAULT_REFRESH_PERIOD    60
+
 /**
  *
  *  Commands EPS to activate/deactivate certain power lines.
  *  Takes 4 boolean values as input, corresponding to power line V1 through V4.
  *  Bool value of 1 activates the line, bool value of 0 deactivates the line.
  *
+ *  Only the lines which changed are sent, one frame per line. Nothing is sent
+ *  when EPS already acknowledged the same state, see PowerBusControlMask().
+ *
  *  Outputs 0 when no faults occur.
  *  Outputs 1 when faults occur.
  *
@@ -31,5 +47,77 @@
  */
 bool PowerBusControl(bool Line1, bool Line2, bool Line3, bool Line4);
 
+/**
+ *
+ *  Commands EPS to set the power lines of a mask.
+ *  A frame is only sent for the lines which differ from the last state confirmed
+ *  by EPS (acknowledgement or telemetry). All lines are sent when the refresh
+ *  period expired, or after a fault since the state is then unknown.
+ *
+ *  Example:
+ *  bool test = PowerBusControlMask(POWER_LINE_V1 | POWER_LINE_V2);
+ *
+ *  Outputs 0 when no faults occur (or nothing had to be sent).
+ *  Outputs 1 when faults occur.
+ *
+ */
+bool PowerBusControlMask(unsigned char mask);
+
+/**
+ *
+ *  Commands EPS to set the power lines of a mask without waiting for the replies.
+ *  The same lines are sent as with PowerBusControlMask(), one after the other:
+ *  the reply of a line sends the next one. It can be called from a callback of
+ *  the request engine (e.g. as soon as the EPS telemetry arrives), the commands
+ *  then compete with the pending housekeeping requests with their critical priority.
+ *
+ *  A fault leaves the state unknown, so the next PowerBusControlMask() commands
+ *  the lines again (with retries). PowerBusControlMask() waits for the pending
+ *  commands first.
+ *
+ *  Outputs 0 when the commands are started (or nothing had to be sent).
+ *  Outputs 1 when they can't be started (e.g. the previous ones are still pending).
+ *
+ */
+bool PowerBusControlAsync(unsigned char mask);
+
+/**
+ *
+ *  Updates the state confirmed by EPS from its telemetry (B1 ~ B4 status).
+ *  Call it once every tick, after the telemetry of EPS is requested.
+ *
+ *  Parameters:
+ *      EPSTelemetryContainer *EPSContainer     Telemetry of EPS
+ *      bool valid                              false if EPS didn't reply this tick
+ *
+ */
+void PowerBusTelemetry(EPSTelemetryContainer *EPSContainer, bool valid);
+
+/**
+ *
+ *  Sets the number of ticks after which an unchanged state is commanded again.
+ *
+ */
+void PowerBusSetRefreshPeriod(unsigned long ticks);
+
+/**
+ *
+ *  State and counters of the power line manager
+ *
+ *  Outputs:
+ *      PowerBusCommandedMask()         Last line mask commanded
+ *      PowerBusConfirmedMask()         Last line mask confirmed by EPS (or POWER_MASK_UNKNOWN)
+ *      PowerBusCommandsSent()          Number of line frames sent to EPS
+ *      PowerBusCommandsSkipped()       Number of commands skipped because EPS had the state
+ *      PowerBusMismatchesCorrected()   Number of commands sent because EPS had another state than
+ *                                      the one commanded before (not counting commanded changes)
+ *
+ */
+unsigned char PowerBusCommandedMask();
+unsigned char PowerBusConfirmedMask();
+unsigned long PowerBusCommandsSent();
+unsigned long PowerBusCommandsSkipped();
+unsigned long PowerBusMismatchesCorrected();
+
 // End include guard for PowerBusControl_H_
 #endif
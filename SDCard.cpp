@@ -0,0 +1,245 @@
+/*
+ *  SDCard.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "SDCard.h"
+#include <driverlib.h>
+
+#define CMD0                0       // GO_IDLE_STATE
+#define CMD8                8       // SEND_IF_COND
+#define CMD16               16      // SET_BLOCKLEN
+#define CMD17               17      // READ_SINGLE_BLOCK
+#define CMD24               24      // WRITE_BLOCK
+#define CMD32               32      // ERASE_WR_BLK_START_ADDR
+#define CMD33               33      // ERASE_WR_BLK_END_ADDR
+#define CMD38               38      // ERASE
+#define CMD55               55      // APP_CMD
+#define CMD58               58      // READ_OCR
+#define ACMD41              41      // SD_SEND_OP_COND
+
+#define R1_IDLE             0x01
+#define DATA_TOKEN          0xFE
+#define DATA_ACCEPTED       0x05
+#define READY_RETRIES       31250   // 8us per byte at 1MHz: about 250ms (worst case programming time)
+#define SDCARD_INIT_SPEED   400000
+#define SDCARD_SPEED        1000000 // Same speed as the FRAM on the shared bus
+
+SDCard::SDCard(DSPI &spi, unsigned long port, unsigned long pin) :
+        line(spi), csPort(port), csPin(pin), blockAddressing(false), version2(false)
+{
+}
+
+void SDCard::select()
+{
+    MAP_GPIO_setOutputLowOnPin(csPort, csPin);
+    line.transfer(0xFF);
+}
+
+void SDCard::deselect()
+{
+    MAP_GPIO_setOutputHighOnPin(csPort, csPin);
+    line.transfer(0xFF); // The card releases MISO after one more byte
+}
+
+bool SDCard::waitReady()
+{
+    for (int i = 0; i < READY_RETRIES; i++)
+    {
+        if (line.transfer(0xFF) == 0xFF)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+unsigned char SDCard::command(unsigned char cmd, unsigned long arg)
+{
+    unsigned char response;
+
+    // Only CMD0 and CMD8 need a valid CRC in SPI mode
+    line.transfer(0x40 | cmd);
+    line.transfer(arg >> 24);
+    line.transfer(arg >> 16);
+    line.transfer(arg >> 8);
+    line.transfer(arg);
+    line.transfer((cmd == CMD0) ? 0x95 : ((cmd == CMD8) ? 0x87 : 0x01));
+
+    // The response comes within 8 bytes
+    for (int i = 0; i < 8; i++)
+    {
+        response = line.transfer(0xFF);
+        if ((response & 0x80) == 0)
+        {
+            break;
+        }
+    }
+    return response;
+}
+
+void SDCard::readOCR(unsigned char *ocr)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        ocr[i] = line.transfer(0xFF);
+    }
+}
+
+bool SDCard::start()
+{
+    unsigned char ocr[4];
+    bool answered;
+
+    MAP_GPIO_setAsOutputPin(csPort, csPin);
+    MAP_GPIO_setOutputHighOnPin(csPort, csPin);
+
+    // The card accepts at most 400kHz until it's initialized
+    line.initMaster(DSPI::MODE0, DSPI::MSBFirst, SDCARD_INIT_SPEED);
+
+    // At least 74 clocks with CS high to enter the native mode
+    for (int i = 0; i < 10; i++)
+    {
+        line.transfer(0xFF);
+    }
+
+    select();
+    answered = (command(CMD0, 0) == R1_IDLE);
+    if (answered)
+    {
+        // SD version 2 echoes the check pattern
+        version2 = (command(CMD8, 0x1AA) == R1_IDLE);
+        if (version2)
+        {
+            readOCR(ocr);
+            answered = (ocr[2] == 0x01) && (ocr[3] == 0xAA);
+        }
+    }
+    deselect();
+
+    line.initMaster(DSPI::MODE0, DSPI::MSBFirst, SDCARD_SPEED);
+    return answered;
+}
+
+int SDCard::initStep()
+{
+    unsigned char ocr[4];
+    unsigned char response;
+    int result = SDCARD_INITIALIZING;
+
+    line.initMaster(DSPI::MODE0, DSPI::MSBFirst, SDCARD_INIT_SPEED);
+    select();
+
+    // The card leaves the idle state at the end of its initialization (HCS: the host supports SDHC)
+    command(CMD55, 0);
+    response = command(ACMD41, version2 ? 0x40000000 : 0);
+    if (response == 0)
+    {
+        // CCS bit of the OCR: the card is addressed by sector
+        blockAddressing = false;
+        if (version2 && (command(CMD58, 0) == 0))
+        {
+            readOCR(ocr);
+            blockAddressing = (ocr[0] & 0x40) != 0;
+        }
+        result = (blockAddressing || (command(CMD16, SDCARD_SECTOR_SIZE) == 0)) ? SDCARD_READY : SDCARD_ERROR;
+    }
+    else if (response != R1_IDLE)
+    {
+        result = SDCARD_ERROR;
+    }
+
+    deselect();
+    line.initMaster(DSPI::MODE0, DSPI::MSBFirst, SDCARD_SPEED);
+    return result;
+}
+
+bool SDCard::writeSector(unsigned long sector, unsigned char *data)
+{
+    unsigned char response;
+
+    select();
+
+    // The previous sector may still be programmed
+    if (!waitReady() || (command(CMD24, blockAddressing ? sector : sector * SDCARD_SECTOR_SIZE) != 0))
+    {
+        deselect();
+        return false;
+    }
+
+    line.transfer(DATA_TOKEN);
+    for (int i = 0; i < SDCARD_SECTOR_SIZE; i++)
+    {
+        line.transfer(data[i]);
+    }
+    line.transfer(0xFF); // CRC (not checked in SPI mode)
+    line.transfer(0xFF);
+
+    response = line.transfer(0xFF) & 0x1F;
+
+    // The card programs the sector while it's deselected
+    deselect();
+    return response == DATA_ACCEPTED;
+}
+
+bool SDCard::readSector(unsigned long sector, unsigned char *data)
+{
+    int i;
+
+    select();
+    if (!waitReady() || (command(CMD17, blockAddressing ? sector : sector * SDCARD_SECTOR_SIZE) != 0))
+    {
+        deselect();
+        return false;
+    }
+
+    for (i = 0; i < READY_RETRIES; i++)
+    {
+        if (line.transfer(0xFF) == DATA_TOKEN)
+        {
+            break;
+        }
+    }
+    if (i == READY_RETRIES)
+    {
+        deselect();
+        return false;
+    }
+
+    for (i = 0; i < SDCARD_SECTOR_SIZE; i++)
+    {
+        data[i] = line.transfer(0xFF);
+    }
+    line.transfer(0xFF); // CRC
+    line.transfer(0xFF);
+
+    deselect();
+    return true;
+}
+
+bool SDCard::erase(unsigned long first, unsigned long last)
+{
+    bool started;
+
+    select();
+    started = waitReady()
+            && (command(CMD32, blockAddressing ? first : first * SDCARD_SECTOR_SIZE) == 0)
+            && (command(CMD33, blockAddressing ? last : last * SDCARD_SECTOR_SIZE) == 0)
+            && (command(CMD38, 0) == 0);
+
+    // The card erases the sectors while it's deselected
+    deselect();
+    return started;
+}
+
+bool SDCard::isBusy()
+{
+    bool busy;
+
+    select();
+    busy = (line.transfer(0xFF) != 0xFF);
+    deselect();
+    return busy;
+}
@@ -0,0 +1,120 @@
+/*
+ *  SDCard.h
+ *
+ *  Driver of an SD card (SDSC or SDHC/SDXC) in SPI mode, 512-byte sectors.
+ *  The card can share the SPI bus with the FRAM: a sector write returns as soon
+ *  as the card accepted the data, and the bus is free while the card programs it
+ *  (see writeSector() and isBusy()).
+ *
+ *  Nothing waits for the card for long: the initialization is done one ACMD41
+ *  at a time (initStep()), and a read, write or erase waits at most 250ms for
+ *  the card to be ready (the longest programming time of the standard). The
+ *  caller bounds its time by checking isBusy() before the next operation.
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef SDCARD_H_
+#define SDCARD_H_
+
+#include "DSPI.h"
+
+#define SDCARD_SECTOR_SIZE          512
+
+#define SDCARD_READY                0
+#define SDCARD_INITIALIZING         1
+#define SDCARD_ERROR                2
+
+class SDCard
+{
+protected:
+    DSPI &line;
+    unsigned long csPort;
+    unsigned long csPin;
+    bool blockAddressing;   // SDHC/SDXC: sector number, SDSC: byte address
+    bool version2;          // The card answered CMD8
+
+    void select();
+    void deselect();
+    unsigned char command(unsigned char cmd, unsigned long arg);
+    bool waitReady();
+    void readOCR(unsigned char *ocr);   // The 4 bytes after the R1 of CMD8 or CMD58
+
+public:
+    SDCard(DSPI &spi, unsigned long port, unsigned long pin);
+
+    /**
+     *
+     *  Put the card in SPI mode and find its version, then call initStep()
+     *  until the card is ready
+     *
+     *  Returns:
+     *      start()                         true if a card answered
+     *
+     */
+    bool start();
+
+    /**
+     *
+     *  Ask the card whether its initialization is over (one ACMD41, less than 1ms).
+     *  The cards take up to 1s to initialize.
+     *
+     *  Returns:
+     *      initStep()                      SDCARD_READY or
+     *                                      SDCARD_INITIALIZING or
+     *                                      SDCARD_ERROR
+     *
+     */
+    int initStep();
+
+    /**
+     *
+     *  Start writing a sector, it doesn't wait for the card to program it
+     *
+     *  Parameters:
+     *      unsigned long sector            Sector number
+     *      unsigned char *data             SDCARD_SECTOR_SIZE bytes
+     *  Returns:
+     *      writeSector()                   true if the card accepted the data
+     *
+     */
+    bool writeSector(unsigned long sector, unsigned char *data);
+
+    /**
+     *
+     *  Read a sector
+     *
+     *  Parameters:
+     *      unsigned long sector            Sector number
+     *  Returns:
+     *      readSector()                    true if the sector was read
+     *      unsigned char *data             SDCARD_SECTOR_SIZE bytes
+     *
+     */
+    bool readSector(unsigned long sector, unsigned char *data);
+
+    /**
+     *
+     *  Start erasing a range of sectors, it doesn't wait for the card to erase them
+     *  (see isBusy()). The erase is fastest on whole erase blocks.
+     *
+     *  Parameters:
+     *      unsigned long first             First sector
+     *      unsigned long last              Last sector (included)
+     *  Returns:
+     *      erase()                         true if the card started the erase
+     *
+     */
+    bool erase(unsigned long first, unsigned long last);
+
+    /**
+     *
+     *  Returns:
+     *      isBusy()                        true while the card programs the last sector
+     *
+     */
+    bool isBusy();
+};
+
+#endif /* SDCARD_H_ */
@@ -0,0 +1,357 @@
+/*
+ *  SDCardAccess.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "SDCardAccess.h"
+
+#ifdef SDCARD_ENABLED
+
+#include "OBCFramAccess.h"
+#include "Communication.h"
+#include <string.h>
+
+//#define SDCARD_DEBUG
+
+#ifdef SDCARD_DEBUG
+    #include "Console.h"
+#endif
+
+static_assert(SDCARD_SECTOR_SIZE % OBCFRAM_LOG_RECORD_SIZE == 0, "Records must not straddle SD sectors");
+static_assert(SDCARD_LOG_FIRST_SECTOR % SDCARD_SEGMENT_SECTORS == 0, "Segments must be aligned to erase blocks");
+
+extern MB85RS fram;
+extern SDCard sdCard;
+
+struct SegmentIndex
+{
+    unsigned long firstSequence;    // SDCARD_NO_SEGMENT: erased or unknown
+    unsigned long firstTime;
+};
+
+// The card is started, then initialized over one or more runs
+typedef enum SDCardState {SD_NOT_STARTED, SD_INITIALIZING, SD_READY} SDCardState;
+
+SDCardState sdState = SD_NOT_STARTED;
+unsigned long sdInitMS;             // Time spent in the initialization of the card
+unsigned long sdRunStartMS;         // Start of the current run
+unsigned long sdNextSequence = 0;   // First record of the next sector to copy
+unsigned long sdErasedSegment = SDCARD_NO_SEGMENT;   // Segment ready to be filled
+unsigned long sdIndexed = 0;        // Number of segments read back in the index
+unsigned long sdSectorsWritten = 0;
+unsigned long sdSegmentsErased = 0;
+SegmentIndex sdIndex[SDCARD_LOG_SEGMENTS];
+unsigned char sdBuffer[SDCARD_SECTOR_SIZE];
+
+/**
+ *
+ *  Segment and sector of the archive holding a record
+ *
+ */
+unsigned long RecordSegment(unsigned long sequence)
+{
+    return (sequence / SDCARD_RECORDS_PER_SEGMENT) % SDCARD_LOG_SEGMENTS;
+}
+
+unsigned long RecordSector(unsigned long sequence)
+{
+    return SDCARD_LOG_FIRST_SECTOR + (sequence / SDCARD_RECORDS_PER_SECTOR)
+            % (SDCARD_LOG_SEGMENTS * SDCARD_SEGMENT_SECTORS);
+}
+
+/**
+ *
+ *  Index a segment from the records of its first sector (the oldest ones
+ *  can be zero when they were overwritten in FRAM before the copy)
+ *
+ */
+void IndexSegment(unsigned long segment, unsigned char *records)
+{
+    unsigned long sequence;
+
+    sdIndex[segment].firstSequence = SDCARD_NO_SEGMENT;
+    for (int i = 0; i < SDCARD_RECORDS_PER_SECTOR; i++)
+    {
+        sequence = GetLong(&records[i * OBCFRAM_LOG_RECORD_SIZE]);
+        if (OBCFramLogCheckRecord(&records[i * OBCFRAM_LOG_RECORD_SIZE])
+            && (RecordSegment(sequence) == segment))
+        {
+            sdIndex[segment].firstSequence = sequence - (sequence % SDCARD_RECORDS_PER_SEGMENT);
+            sdIndex[segment].firstTime = GetLong(&records[i * OBCFRAM_LOG_RECORD_SIZE + 4]);
+            return;
+        }
+    }
+}
+
+/**
+ *
+ *  Please read SDCardAccess.h
+ *
+ */
+void SDCardInit()
+{
+    for (int i = 0; i < SDCARD_LOG_SEGMENTS; i++)
+    {
+        sdIndex[i].firstSequence = SDCARD_NO_SEGMENT;
+    }
+    sdIndexed = 0;
+    sdState = SD_NOT_STARTED;
+    sdErasedSegment = SDCARD_NO_SEGMENT;
+
+    // After a reset, start again from the oldest record in FRAM
+    sdNextSequence = OBCFramLogFirstSequence() - (OBCFramLogFirstSequence() % SDCARD_RECORDS_PER_SECTOR);
+}
+
+/**
+ *
+ *  true while the current run has time left
+ *
+ */
+bool RunTimeLeft()
+{
+    return CommunicationTimeMS() - sdRunStartMS < SDCARD_RUN_BUDGET_MS;
+}
+
+/**
+ *
+ *  Wait for the card to finish programming or erasing, within the time of the run
+ *
+ */
+bool CardReady()
+{
+    while (RunTimeLeft())
+    {
+        if (!sdCard.isBusy())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ *
+ *  Start and initialize the card, within the time of the run. The card gets
+ *  SDCARD_INIT_TIMEOUT_MS in total, then it's started again.
+ *
+ */
+bool InitCard()
+{
+    unsigned long start;
+    int result = SDCARD_INITIALIZING;
+
+    if (sdState == SD_NOT_STARTED)
+    {
+        if (!sdCard.start())
+        {
+            return false;
+        }
+        sdState = SD_INITIALIZING;
+        sdInitMS = 0;
+    }
+
+    start = CommunicationTimeMS();
+    while ((result == SDCARD_INITIALIZING) && RunTimeLeft()
+           && (sdInitMS + (CommunicationTimeMS() - start) < SDCARD_INIT_TIMEOUT_MS))
+    {
+        result = sdCard.initStep();
+    }
+    sdInitMS += CommunicationTimeMS() - start;
+
+    if (result == SDCARD_READY)
+    {
+        sdState = SD_READY;
+    }
+    else if ((result == SDCARD_ERROR) || (sdInitMS >= SDCARD_INIT_TIMEOUT_MS))
+    {
+        sdState = SD_NOT_STARTED;
+    }
+
+    #ifdef SDCARD_DEBUG
+        Console::log("InitCard(): %d ms, card %s", (int) sdInitMS, (sdState == SD_READY) ? "ready" : "not ready");
+    #endif
+    return sdState == SD_READY;
+}
+
+/**
+ *
+ *  Read the records of a sector from the FRAM. The ones that were already
+ *  overwritten in FRAM are zero.
+ *
+ */
+bool ReadSectorRecords(unsigned long sequence, unsigned char *sector)
+{
+    unsigned long first = OBCFramLogFirstSequence();
+    unsigned long skip = 0;
+
+    if (first > sequence)
+    {
+        skip = first - sequence;
+        memset(sector, 0, skip * OBCFRAM_LOG_RECORD_SIZE);
+    }
+    return OBCFramLogReadRaw(fram, sequence + skip, SDCARD_RECORDS_PER_SECTOR - skip,
+                             &sector[skip * OBCFRAM_LOG_RECORD_SIZE]) == FRAM_OPERATION_SUCCESS;
+}
+
+/**
+ *
+ *  One run of SDCardAccess(): it returns when the time of the run is used up,
+ *  the next run resumes where it stopped
+ *
+ */
+void SDCardRun()
+{
+    unsigned long first, segment;
+
+    if ((sdState != SD_READY) && !InitCard())
+    {
+        return;
+    }
+
+    // Rebuild the index after a reset
+    while (sdIndexed < SDCARD_LOG_SEGMENTS)
+    {
+        if (!CardReady())
+        {
+            return;
+        }
+        if (sdIndex[sdIndexed].firstSequence == SDCARD_NO_SEGMENT)
+        {
+            if (!sdCard.readSector(SDCARD_LOG_FIRST_SECTOR + sdIndexed * SDCARD_SEGMENT_SECTORS, sdBuffer))
+            {
+                sdState = SD_NOT_STARTED;
+                return;
+            }
+            IndexSegment(sdIndexed, sdBuffer);
+        }
+        sdIndexed++;
+    }
+
+    // Skip the sectors that are not in FRAM anymore
+    first = OBCFramLogFirstSequence() - (OBCFramLogFirstSequence() % SDCARD_RECORDS_PER_SECTOR);
+    if ((long)(sdNextSequence - first) < 0)
+    {
+        sdNextSequence = first;
+    }
+
+    while (OBCFramLogNextSequence() - sdNextSequence >= SDCARD_RECORDS_PER_SECTOR)
+    {
+        // Wait for the end of an erase or of the previous sector
+        if (!CardReady())
+        {
+            return;
+        }
+
+        // Retire the oldest segment before the first write in it
+        segment = RecordSegment(sdNextSequence);
+        if (segment != sdErasedSegment)
+        {
+            if (sdIndex[segment].firstSequence == sdNextSequence - (sdNextSequence % SDCARD_RECORDS_PER_SEGMENT))
+            {
+                // Resumed in a segment of this round (e.g. after a reset)
+                sdErasedSegment = segment;
+            }
+            else
+            {
+                sdIndex[segment].firstSequence = SDCARD_NO_SEGMENT;
+                if (!sdCard.erase(SDCARD_LOG_FIRST_SECTOR + segment * SDCARD_SEGMENT_SECTORS,
+                                  SDCARD_LOG_FIRST_SECTOR + (segment + 1) * SDCARD_SEGMENT_SECTORS - 1))
+                {
+                    sdState = SD_NOT_STARTED;
+                    return;
+                }
+                sdErasedSegment = segment;
+                sdSegmentsErased++;
+                continue;
+            }
+        }
+
+        // The FRAM is read while the card programs the previous sector: the card already
+        // got the whole sector, so the buffer can be filled again
+        if (!ReadSectorRecords(sdNextSequence, sdBuffer))
+        {
+            return;
+        }
+
+        if (!sdCard.writeSector(RecordSector(sdNextSequence), sdBuffer))
+        {
+            // Initialize the card again in the next run, the sector is copied again
+            sdState = SD_NOT_STARTED;
+            #ifdef SDCARD_DEBUG
+                Console::log("SDCardAccess(): write of record %d failed", (int) sdNextSequence);
+            #endif
+            return;
+        }
+
+        if (sdIndex[segment].firstSequence == SDCARD_NO_SEGMENT)
+        {
+            IndexSegment(segment, sdBuffer);
+        }
+        sdNextSequence += SDCARD_RECORDS_PER_SECTOR;
+        sdSectorsWritten++;
+    }
+}
+
+/**
+ *
+ *  Please read SDCardAccess.h
+ *
+ */
+void SDCardAccess()
+{
+    // The time of the run is counted by the 1ms tick of the request engine
+    CommunicationHoldClock();
+    sdRunStartMS = CommunicationTimeMS();
+
+    SDCardRun();
+
+    CommunicationReleaseClock();
+}
+
+/**
+ *
+ *  Please read SDCardAccess.h
+ *
+ */
+unsigned long SDCardSeek(unsigned long time)
+{
+    unsigned long found = SDCARD_NO_SEGMENT;
+    unsigned long oldest = SDCARD_NO_SEGMENT;
+
+    for (int i = 0; i < SDCARD_LOG_SEGMENTS; i++)
+    {
+        if (sdIndex[i].firstSequence == SDCARD_NO_SEGMENT)
+        {
+            continue;
+        }
+        if ((oldest == SDCARD_NO_SEGMENT) || (sdIndex[i].firstSequence < oldest))
+        {
+            oldest = sdIndex[i].firstSequence;
+        }
+        if ((sdIndex[i].firstTime <= time)
+            && ((found == SDCARD_NO_SEGMENT) || (sdIndex[i].firstSequence > found)))
+        {
+            found = sdIndex[i].firstSequence;
+        }
+    }
+    return (found == SDCARD_NO_SEGMENT) ? oldest : found;
+}
+
+bool SDCardRead(unsigned long sequence, unsigned char *records)
+{
+    return (sdState == SD_READY) && sdCard.readSector(RecordSector(sequence), records);
+}
+
+unsigned long SDCardSectorsWritten()
+{
+    return sdSectorsWritten;
+}
+
+unsigned long SDCardSegmentsErased()
+{
+    return sdSegmentsErased;
+}
+
+#endif /* SDCARD_ENABLED */
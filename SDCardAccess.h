@@ -0,0 +1,130 @@
+/*
+ *  SDCardAccess.h
+ *
+ *  Telemetry archive on the SD card: a copy of the telemetry history of the FRAM
+ *  (see OBCFramLog.h), stored as a log of segments.
+ *
+ *  Every SD sector holds SDCARD_RECORDS_PER_SECTOR consecutive log records as they
+ *  are stored in FRAM, and record n always goes to the same sector. Copying a
+ *  sector again (e.g. after a reset) writes the same data, so the progress is
+ *  only kept in RAM. Only full sectors are copied.
+ *
+ *  The archive is a ring of SDCARD_LOG_SEGMENTS segments, aligned to the erase
+ *  blocks of the card. A segment is erased as a whole before its first sector is
+ *  written, which retires the oldest data, and then filled sequentially, so a
+ *  power loss can only leave the current segment incomplete. The records carry
+ *  their sequence number and CRC, so a reader detects the sectors that were not
+ *  written.
+ *
+ *  A sector isn't always written once per round: the position of the copy is
+ *  only kept in RAM, so after a reset it restarts from the oldest record in FRAM
+ *  and writes again the sectors still in FRAM (up to a whole FRAM log per reset).
+ *  They get the same data, the cost is the extra writes (see the write
+ *  amplification reported by tests/SDCardArchiveTest.cpp).
+ *
+ *  A small index in RAM holds the first sequence number and time of every
+ *  segment. It is rebuilt after a reset from the first sector of each segment.
+ *
+ *  SDCardAccess() runs in SDCardTask, after StateMachine(). Each run stops after
+ *  SDCARD_RUN_BUDGET_MS (measured by the 1ms tick of Communication.h) and the
+ *  work (card initialization, index rebuild, copy) resumes in the next run. A
+ *  run can exceed its budget by one operation of the card (at most 250ms, see
+ *  SDCard.h), so with the tick of StateMachine() it stays well below the 2.5s
+ *  of the watchdog.
+ *
+ *  The chip select of the card on the OBC board isn't confirmed yet: the archive
+ *  is only built when SDCARD_CS_PORT and SDCARD_CS_PIN are defined (in the build
+ *  options of the project), else SDCARD_ENABLED stays undefined and main.cpp
+ *  doesn't create SDCardTask.
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef SDCARDACCESS_H_
+#define SDCARDACCESS_H_
+
+#include "SDCard.h"
+#include "OBCFramLog.h"
+
+#if defined(SDCARD_CS_PORT) && defined(SDCARD_CS_PIN)
+#define SDCARD_ENABLED
+#endif
+
+// The size of the ring can be changed in the build options (e.g. a small ring for the host test)
+#ifndef SDCARD_LOG_FIRST_SECTOR
+#define SDCARD_LOG_FIRST_SECTOR     2048        // Leaves the first MB for a partition table / file system
+#endif
+#ifndef SDCARD_SEGMENT_SECTORS
+#define SDCARD_SEGMENT_SECTORS      2048        // 1MB, a multiple of the erase block size of the cards
+#endif
+#ifndef SDCARD_LOG_SEGMENTS
+#define SDCARD_LOG_SEGMENTS         256         // 256MB, then the oldest segment is retired
+#endif
+
+#define SDCARD_RECORDS_PER_SECTOR   (SDCARD_SECTOR_SIZE / OBCFRAM_LOG_RECORD_SIZE)
+#define SDCARD_RECORDS_PER_SEGMENT  (SDCARD_SEGMENT_SECTORS * SDCARD_RECORDS_PER_SECTOR)
+#define SDCARD_RUN_BUDGET_MS        200         // Time of one run of SDCardAccess()
+#define SDCARD_INIT_TIMEOUT_MS      1000        // Time given to the card to initialize (ACMD41)
+#define SDCARD_NO_SEGMENT           0xFFFFFFFF
+
+/**
+ *
+ *  Reset the state of the archive, the card is initialized by SDCardAccess()
+ *
+ */
+void SDCardInit();
+
+/**
+ *
+ *  Initialize the card, rebuild the index, then copy the full sectors of new
+ *  records from the FRAM to the SD card, for at most SDCARD_RUN_BUDGET_MS.
+ *  The next sector is read from the FRAM while the card programs the previous one.
+ *
+ */
+void SDCardAccess();
+
+/**
+ *
+ *  Find the segment of the archive that holds a time
+ *
+ *  Parameters:
+ *      unsigned long time              The time
+ *
+ *  Returns:
+ *      SDCardSeek()                    Sequence number of the first record of the newest
+ *                                      segment starting at or before the time (the oldest
+ *                                      segment if they are all newer), SDCARD_NO_SEGMENT
+ *                                      if the archive is empty. The records are then
+ *                                      read forward with SDCardRead().
+ *
+ */
+unsigned long SDCardSeek(unsigned long time);
+
+/**
+ *
+ *  Read the sector of the archive holding a record
+ *
+ *  Parameters:
+ *      unsigned long sequence          Sequence number of the record
+ *
+ *  Returns:
+ *      SDCardRead()                    true if the sector was read
+ *      unsigned char *records          The SDCARD_RECORDS_PER_SECTOR records of the sector,
+ *                                      to check with OBCFramLogCheckRecord() and their
+ *                                      sequence number
+ *
+ */
+bool SDCardRead(unsigned long sequence, unsigned char *records);
+
+/**
+ *
+ *  Returns:
+ *      SDCardSectorsWritten()          Number of sectors written since the start
+ *      SDCardSegmentsErased()          Number of segments erased since the start
+ *
+ */
+unsigned long SDCardSectorsWritten();
+unsigned long SDCardSegmentsErased();
+
+#endif /* SDCARDACCESS_H_ */
@@ -23,18 +23,18 @@ void SafeMode(OBCTelemetryContainer *OBCContainer)
     #ifdef SAFEMODE_DEBUG
         Console::log("SafeMode() activated.\n");
     #endif
-    // === SfM-OBC-1 ===
-    // Dump telemetry in FRAM to SD card
-    // - To be implemented later.
-
     // === SfM-OBC-2 ===
-    // Command EPS to turn off other power lines except V1
+    // Command EPS to turn off other power lines except V1 (before anything else)
     PowerBusControl(1,0,0,0);
 
     #ifdef SAFEMODE_DEBUG
         Console::log("LineControl(1,0,0,0) called.\n");
     #endif
 
+    // === SfM-OBC-1 ===
+    // Dump telemetry in FRAM to SD card
+    // - Done by SDCardTask in every mode, within its own time budget (see SDCardAccess.h)
+
     // === SfM-OBC-3 ===
     // === Mode exit conditions ====
     // To avoid satellite getting stuck in Safe Mode when unexpected behaviour occurs,
@@ -6,14 +6,19 @@
  */
 
 #define STATEMACHINE_DEBUG
+#define TELEMETRY_LOG_PERIOD    60  // Seconds between two samples of a container in the FRAM log
 
 #include "ActivationMode.h"
 #include "DeployMode.h"
 #include "SafeMode.h"
 #include "ADCSMode.h"
+#include "PowerBusControl.h"
 //#include "NominalMode.h"
 #include "Communication.h"
 #include "OBCFramAccess.h"
+#include "OBCFramLog.h"
+#include "TelemetryLog.h"
+#include "TelemetryTrend.h"
 #include "ADBTelemetryContainer.h"
 #include "ADCSTelemetryContainer.h"
 #include "COMMSTelemetryContainer.h"
@@ -38,6 +43,40 @@ extern MB85RS fram;
 
 extern void acquireTelemetry(OBCTelemetryContainer *tc);
 
+// Time of the telemetry history in seconds, counted by StateMachine() (period: 1s).
+// It goes on after the newest record of the FRAM log, so the log stays in time order after a reset.
+unsigned long stateMachineTime;
+
+/**
+ *
+ *  Check if voltage is high enough, else go into safe mode.
+ *  The power lines are switched off at once (SfM-OBC-2), SafeMode() only
+ *  confirms them once the telemetry sweep is done.
+ *
+ */
+void CheckBatteryVoltage()
+{
+    if(EPSContainer.getBattVoltage() < OBCContainer.getSMVoltage() && OBCContainer.getMode() != ACTIVATIONMODE && OBCContainer.getMode() != DEPLOYMENTMODE)
+    {
+        OBCContainer.setMode(SAFEMODE);
+        PowerBusControlAsync(POWER_LINE_V1);
+    }
+}
+
+/**
+ *
+ *  Called as soon as EPS replied in the telemetry sweep, so the power commands
+ *  don't wait for the other modules
+ *
+ */
+void EPSReceived(TelemetrySweepSlot &)
+{
+    // The EPS telemetry tells which power lines are really on
+    PowerBusTelemetry(&EPSContainer, true);
+
+    CheckBatteryVoltage();
+}
+
 void StateMachineInit()
 {
 #ifdef STATEMACHINE_DEBUG
@@ -45,8 +84,18 @@ void StateMachineInit()
     // fram.erase();
 #endif
 
-    // Load data from FRAM
-    if (OBCFramRead(fram, OBCFRAM_VARIABLES_ADDR, OBCContainer.getArray(), OBCContainer.size()) == FRAM_OPERATION_SUCCESS)
+    // Load all the containers from FRAM at once (same order as obcFramBlocks)
+    unsigned char *arrays[OBCFRAM_BLOCKS] = {ADBContainer.getArray(), ADCSContainer.getArray(),
+                                             COMMSContainer.getArray(), EPSContainer.getArray(),
+                                             PROPContainer.getArray(), OBCContainer.getArray()};
+    int results[OBCFRAM_BLOCKS];
+    int restored = OBCFramRestore(fram, arrays, results);
+
+#ifdef STATEMACHINE_DEBUG
+    Console::log("StateMachineInit(): %d of %d containers restored from FRAM", restored, (int) OBCFRAM_BLOCKS);
+#endif
+
+    if (results[OBCFRAM_BLOCKS - 1] == FRAM_OPERATION_SUCCESS)
     {
         OBCContainer.NormalInit();
     }
@@ -55,49 +104,91 @@ void StateMachineInit()
         OBCContainer.FirstBootInit(); // Including the BootCount
     }
 
-    // TODO: Copy data from FRAM to the SD card
+    // Find the head of the telemetry history, SDCardTask copies it to the SD card
+    OBCFramLogInit(fram);
+    TelemetryLogInit();
+
+    static unsigned char record[OBCFRAM_LOG_RECORD_SIZE];
+    stateMachineTime = OBCContainer.getTotalUpTime();
+    if ((OBCFramLogCount() > 0)
+        && (OBCFramLogReadRaw(fram, OBCFramLogNextSequence() - 1, 1, record) == FRAM_OPERATION_SUCCESS)
+        && OBCFramLogCheckRecord(record) && (GetLong(&record[4]) >= stateMachineTime))
+    {
+        stateMachineTime = GetLong(&record[4]) + 1;
+    }
 
 }
 
 void StateMachine()
 {
+    stateMachineTime++;
+
     // Kick the external watchdog (time window: 2.5s)
     reset.refreshConfiguration();
     reset.kickExternalWatchDog();
 
+    // Start the bus time budget of this tick, retries never exceed it
+    CommunicationStartTick(COMMUNICATION_DEFAULT_BUDGET_MS);
+
     // Acquire telemetry from OBC
     hk.acquireTelemetry(acquireTelemetry);
 
-    // Request telemetry from active modules
-    char response;
-
-    response = RequestTelemetry(ADB, &ADBContainer);
-    OBCContainer.setADBResponse(response);
-
-    response = RequestTelemetry(ADCS, &ADCSContainer);
-    OBCContainer.setADCSResponse(response);
-
-    response = RequestTelemetry(COMMS, &COMMSContainer);
-    OBCContainer.setCOMMSResponse(response);
+    // Request telemetry from active modules (all at the same time)
+    TelemetrySweepSlot sweep[] = {TelemetrySweepSlotOf(ADB, ADBContainer),
+                                  TelemetrySweepSlotOf(ADCS, ADCSContainer),
+                                  TelemetrySweepSlotOf(COMMS, COMMSContainer),
+                                  TelemetrySweepSlotOf(EPS, EPSContainer),
+                                  TelemetrySweepSlotOf(PROP, PROPContainer)};
+    sweep[3].received = EPSReceived;
+    RequestTelemetrySweep(sweep, 5);
+
+    OBCContainer.setADBResponse(sweep[0].response);
+    OBCContainer.setADCSResponse(sweep[1].response);
+    OBCContainer.setCOMMSResponse(sweep[2].response);
+    OBCContainer.setEPSResponse(sweep[3].response);
+    OBCContainer.setPROPResponse(sweep[4].response);
+
+    // Without a reply of EPS, decide on its last telemetry
+    if (sweep[3].response != SERVICE_RESPONSE_REPLY)
+    {
+        PowerBusTelemetry(&EPSContainer, false);
+        CheckBatteryVoltage();
+    }
 
-    response = RequestTelemetry(EPS, &EPSContainer);
-    OBCContainer.setEPSResponse(response);
+    OBCContainer.setRetryCount(CommunicationRetryCount());
+    OBCContainer.setTimeoutCount(CommunicationTimeoutCount());
 
-    response = RequestTelemetry(PROP, &PROPContainer);
-    OBCContainer.setPROPResponse(response);
+    // Save the changed lines of the containers in FRAM. TODO: error handling
+    OBCFramWriteLines(fram, OBCFRAM_ADBTM_ADDR, ADBContainer.getArray(), ADBContainer.size(), sweep[0].dirtyLines);
+    OBCFramWriteLines(fram, OBCFRAM_ADCSTM_ADDR, ADCSContainer.getArray(), ADCSContainer.size(), sweep[1].dirtyLines);
+    OBCFramWriteLines(fram, OBCFRAM_COMMSTM_ADDR, COMMSContainer.getArray(), COMMSContainer.size(), sweep[2].dirtyLines);
+    OBCFramWriteLines(fram, OBCFRAM_EPSTM_ADDR, EPSContainer.getArray(), EPSContainer.size(), sweep[3].dirtyLines);
+    OBCFramWriteLines(fram, OBCFRAM_PROPTM_ADDR, PROPContainer.getArray(), PROPContainer.size(), sweep[4].dirtyLines);
+    OBCFramWriteLines(fram, OBCFRAM_VARIABLES_ADDR, OBCContainer.getArray(), OBCContainer.size(), OBCContainer.getDirtyLines());
+    OBCContainer.clearDirtyLines();
 
-    // Save containers in FRAM. TODO: error handling
-    OBCFramWrite(fram, OBCFRAM_ADBTM_ADDR, ADBContainer.getArray(), ADBContainer.size());
-    OBCFramWrite(fram, OBCFRAM_ADCSTM_ADDR, ADCSContainer.getArray(), ADCSContainer.size());
-    OBCFramWrite(fram, OBCFRAM_COMMSTM_ADDR, COMMSContainer.getArray(), COMMSContainer.size());
-    OBCFramWrite(fram, OBCFRAM_EPSTM_ADDR, EPSContainer.getArray(), EPSContainer.size());
-    OBCFramWrite(fram, OBCFRAM_PROPTM_ADDR, PROPContainer.getArray(), PROPContainer.size());
-    OBCFramWrite(fram, OBCFRAM_VARIABLES_ADDR, OBCContainer.getArray(), OBCContainer.size());
+    // Keep the telemetry history in the FRAM log, compressed (only the modules which replied)
+    if (stateMachineTime % TELEMETRY_LOG_PERIOD == 0)
+    {
+        for (int i = 0; i < 5; i++)
+        {
+            if (sweep[i].response == SERVICE_RESPONSE_REPLY)
+            {
+                TelemetryLogAppend(fram, stateMachineTime, sweep[i].destination, sweep[i].array, sweep[i].size);
+            }
+        }
+        TelemetryLogAppend(fram, stateMachineTime, OBC, OBCContainer.getArray(), OBCContainer.size());
+        TelemetryLogFlush(fram);
+    }
 
-    // Check if voltage is high enough, else go into safe mode
-    if(EPSContainer.getBattVoltage() < OBCContainer.getSMVoltage() && OBCContainer.getMode() != ACTIVATIONMODE && OBCContainer.getMode() != DEPLOYMENTMODE)
+    // Keep the recent trend of the power telemetry (only fresh EPS telemetry). The bus voltage
+    // and the temperature are in the container of hk, filled by acquireTelemetry() in this tick.
+    if ((stateMachineTime % TREND_PERIOD == 0) && (sweep[3].response == SERVICE_RESPONSE_REPLY))
     {
-        OBCContainer.setMode(SAFEMODE);
+        OBCTelemetryContainer *acquired = static_cast<OBCTelemetryContainer *>(hk.getTelemetry());
+        signed short trend[TREND_SERIES] = {(signed short)EPSContainer.getBattVoltage(), EPSContainer.getBattCurrent(),
+                                            (signed short)acquired->getBusVoltage(), acquired->getTemperature()};
+        TrendAppend(stateMachineTime, trend);
     }
 
     switch(OBCContainer.getMode())
@@ -119,4 +210,5 @@ void StateMachine()
             break;
      }
 
+    CommunicationEndTick();
 }
@@ -0,0 +1,109 @@
+/*
+ *  TelemetryCodec.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "TelemetryCodec.h"
+
+/**
+ *
+ *  Byte of the previous sample (0 for a key frame)
+ *
+ */
+static inline unsigned char Previous(const unsigned char *previous, int i)
+{
+    return (previous != 0) ? previous[i] : 0;
+}
+
+/**
+ *
+ *  Please read TelemetryCodec.h
+ *
+ */
+int TelemetryEncode(const unsigned char *previous, const unsigned char *current, int size,
+                    unsigned char *output, int capacity)
+{
+    int in = 0;
+    int out = 0;
+    int run;
+
+    while (in < size)
+    {
+        // Unchanged bytes
+        run = 0;
+        while ((in + run < size) && (run < TELEMETRYCODEC_MAX_RUN)
+               && (current[in + run] == Previous(previous, in + run)))
+        {
+            run++;
+        }
+        if (run > 0)
+        {
+            if (out + 1 > capacity)
+            {
+                return TELEMETRYCODEC_ERROR;
+            }
+            output[out++] = run - 1;
+            in += run;
+            continue;
+        }
+
+        // Changed bytes, a single unchanged byte between two changes is kept in the run
+        // (a run token would cost as much)
+        while ((in + run < size) && (run < TELEMETRYCODEC_MAX_RUN)
+               && ((current[in + run] != Previous(previous, in + run))
+                   || ((in + run + 1 < size) && (current[in + run + 1] != Previous(previous, in + run + 1)))))
+        {
+            run++;
+        }
+        if (out + 1 + run > capacity)
+        {
+            return TELEMETRYCODEC_ERROR;
+        }
+        output[out++] = 0x80 | (run - 1);
+        for (int i = 0; i < run; i++)
+        {
+            output[out++] = current[in + i] ^ Previous(previous, in + i);
+        }
+        in += run;
+    }
+    return out;
+}
+
+int TelemetryDecode(const unsigned char *previous, const unsigned char *input, int length,
+                    unsigned char *current, int size)
+{
+    int in = 0;
+    int out = 0;
+    int run;
+
+    while (in < length)
+    {
+        run = (input[in] & 0x7F) + 1;
+        if (out + run > size)
+        {
+            return TELEMETRYCODEC_ERROR;
+        }
+
+        if ((input[in++] & 0x80) == 0)
+        {
+            for (int i = 0; i < run; i++, out++)
+            {
+                current[out] = Previous(previous, out);
+            }
+        }
+        else
+        {
+            if (in + run > length)
+            {
+                return TELEMETRYCODEC_ERROR;
+            }
+            for (int i = 0; i < run; i++, out++)
+            {
+                current[out] = input[in++] ^ Previous(previous, out);
+            }
+        }
+    }
+    return (out == size) ? size : TELEMETRYCODEC_ERROR;
+}
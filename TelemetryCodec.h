@@ -0,0 +1,65 @@
+/*
+ *  TelemetryCodec.h
+ *
+ *  Compression of a telemetry array against the previous sample of the same
+ *  container: most bytes don't change from one sample to the next, so the XOR of
+ *  both arrays is mostly zero and is run-length encoded.
+ *
+ *  Encoded format, a sequence of tokens:
+ *      0x00 ~ 0x7F         Run of (token + 1) unchanged bytes
+ *      0x80 ~ 0xFF         (token - 0x7F) bytes follow, XOR of the new and the previous values
+ *
+ *  A sample encoded without a previous one (NULL) is a key frame: it's decoded
+ *  without any other sample. The decoder only uses this file and TelemetryCodec.cpp,
+ *  so the ground software can build them as they are.
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef TELEMETRYCODEC_H_
+#define TELEMETRYCODEC_H_
+
+#define TELEMETRYCODEC_MAX_RUN          128
+#define TELEMETRYCODEC_ERROR            -1
+
+// Worst case size of an encoded array (every byte changed)
+#define TELEMETRYCODEC_MAX_SIZE(size)   ((size) + ((size) + TELEMETRYCODEC_MAX_RUN - 1) / TELEMETRYCODEC_MAX_RUN)
+
+/**
+ *
+ *  Encode a telemetry array
+ *
+ *  Parameters:
+ *      unsigned char *previous         The previous sample (size bytes), NULL for a key frame
+ *      unsigned char *current          The new sample
+ *      int size                        The size of the samples
+ *      int capacity                    The size of output
+ *  Returns:
+ *      TelemetryEncode()               Size of the encoded array or
+ *                                      TELEMETRYCODEC_ERROR (more than capacity)
+ *      unsigned char *output           The encoded array
+ *
+ */
+int TelemetryEncode(const unsigned char *previous, const unsigned char *current, int size,
+                    unsigned char *output, int capacity);
+
+/**
+ *
+ *  Decode a telemetry array
+ *
+ *  Parameters:
+ *      unsigned char *previous         The previous sample (size bytes), NULL for a key frame
+ *      unsigned char *input            The encoded array
+ *      int length                      The size of the encoded array
+ *      int size                        The size of the samples
+ *  Returns:
+ *      TelemetryDecode()               size or
+ *                                      TELEMETRYCODEC_ERROR (the encoded array is corrupted)
+ *      unsigned char *current          The new sample (it can be previous itself)
+ *
+ */
+int TelemetryDecode(const unsigned char *previous, const unsigned char *input, int length,
+                    unsigned char *current, int size);
+
+#endif /* TELEMETRYCODEC_H_ */
@@ -0,0 +1,107 @@
+/*
+ *  TelemetryField.h
+ *
+ *  Compile-time descriptors of the fields of a telemetry array. The values are
+ *  big-endian in the array (as on the bus). The offset and the size are template
+ *  parameters: a 16 or 32 bits field is accessed through BigEndian.h, the others
+ *  byte by byte.
+ *
+ *  A container declares its fields once, e.g.
+ *      typedef TelemetryField<unsigned short, 24, 2> BusVoltageField;
+ *      typedef TelemetryFlag<7, 0x02> BusStatusField;
+ *  and its accessors use them:
+ *      return BusVoltageField::get(telemetry);
+ *  The offset and the size are also known to the code which saves the changes
+ *  (see DirtyLines.h).
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef TELEMETRYFIELD_H_
+#define TELEMETRYFIELD_H_
+
+#include "BigEndian.h"
+
+/**
+ *
+ *  A value of Width bytes at Offset, read and written as type T
+ *  (unsigned or signed integer, or enum)
+ *
+ */
+template <typename T, unsigned int Offset, unsigned int Width>
+class TelemetryField
+{
+    static_assert((Width >= 1) && (Width <= 4), "A field holds 1 to 4 bytes");
+
+public:
+    static constexpr unsigned int offset = Offset;
+    static constexpr unsigned int width = Width;
+
+    static inline T get(const unsigned char *telemetry)
+    {
+        unsigned long ulong = 0;
+
+        // 16 and 32 bits fields through BigEndian.h, 1 and 3 bytes fields byte by byte
+        if (Width == 2)
+        {
+            return (T)BigEndianLoad16(&telemetry[Offset]);
+        }
+        if (Width == 4)
+        {
+            return (T)BigEndianLoad32(&telemetry[Offset]);
+        }
+        for (unsigned int i = 0; i < Width; i++)
+        {
+            ulong = (ulong << 8) | telemetry[Offset + i];
+        }
+        return (T)ulong;
+    }
+
+    static inline void set(unsigned char *telemetry, T value)
+    {
+        unsigned long ulong = (unsigned long)value;
+
+        if (Width == 2)
+        {
+            BigEndianStore16(&telemetry[Offset], (uint16_t)ulong);
+            return;
+        }
+        if (Width == 4)
+        {
+            BigEndianStore32(&telemetry[Offset], (uint32_t)ulong);
+            return;
+        }
+        for (unsigned int i = Width; i > 0; i--)
+        {
+            telemetry[Offset + i - 1] = (unsigned char)ulong;
+            ulong >>= 8;
+        }
+    }
+};
+
+/**
+ *
+ *  A flag (the bits of Mask) in the byte at Offset
+ *
+ */
+template <unsigned int Offset, unsigned char Mask>
+class TelemetryFlag
+{
+public:
+    static constexpr unsigned int offset = Offset;
+    static constexpr unsigned int width = 1;
+
+    static inline bool get(const unsigned char *telemetry)
+    {
+        return (telemetry[Offset] & Mask) != 0;
+    }
+
+    static inline void set(unsigned char *telemetry, bool value)
+    {
+        // -value: all bits set when true
+        telemetry[Offset] = (telemetry[Offset] & (unsigned char)~Mask) | (Mask & (unsigned char)-(int)value);
+    }
+};
+
+#endif /* TELEMETRYFIELD_H_ */
@@ -0,0 +1,174 @@
+/*
+ *  TelemetryLog.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "TelemetryLog.h"
+#include "OBCFramAccess.h"
+#include <string.h>
+
+static_assert((ADB_CONTAINER_SIZE <= TELEMETRYLOG_MAX_SAMPLE) && (ADCS_CONTAINER_SIZE <= TELEMETRYLOG_MAX_SAMPLE)
+              && (COMMS_CONTAINER_SIZE <= TELEMETRYLOG_MAX_SAMPLE) && (EPS_CONTAINER_SIZE <= TELEMETRYLOG_MAX_SAMPLE)
+              && (PROP_CONTAINER_SIZE <= TELEMETRYLOG_MAX_SAMPLE) && (OBC_CONTAINER_SIZE <= TELEMETRYLOG_MAX_SAMPLE),
+              "A container is larger than TELEMETRYLOG_MAX_SAMPLE");
+static_assert(TELEMETRYLOG_ENTRY_HEADER + TELEMETRYCODEC_MAX_SIZE(TELEMETRYLOG_MAX_SAMPLE) <= OBCFRAM_LOG_MAX_PAYLOAD,
+              "A key frame of the largest container doesn't fit in a record");
+
+typedef struct TelemetryLogHistory
+{
+    unsigned char id;
+    unsigned char size;             // 0: no previous sample, the next one is a key frame
+    unsigned char sinceKeyFrame;    // Samples logged since the last key frame
+    unsigned char sample[TELEMETRYLOG_MAX_SAMPLE];
+} TelemetryLogHistory;
+
+TelemetryLogHistory logHistory[TELEMETRYLOG_CONTAINERS];
+unsigned char logPacked[OBCFRAM_LOG_MAX_PAYLOAD];
+int logPackedSize;
+unsigned long logPackedTime;
+
+/**
+ *
+ *  Previous sample of a container, NULL when the table is full (always key frames)
+ *
+ */
+TelemetryLogHistory *GetHistory(unsigned char id)
+{
+    TelemetryLogHistory *unused = 0;
+
+    for (int i = 0; i < TELEMETRYLOG_CONTAINERS; i++)
+    {
+        if ((logHistory[i].id == id) && (logHistory[i].size != 0))
+        {
+            return &logHistory[i];
+        }
+        if ((unused == 0) && (logHistory[i].size == 0))
+        {
+            unused = &logHistory[i];
+        }
+    }
+    if (unused != 0)
+    {
+        unused->id = id;
+    }
+    return unused;
+}
+
+/**
+ *
+ *  The samples of the packed record were not stored, their deltas can't be decoded
+ *
+ */
+void ForgetHistory()
+{
+    for (int i = 0; i < TELEMETRYLOG_CONTAINERS; i++)
+    {
+        logHistory[i].size = 0;
+    }
+}
+
+/**
+ *
+ *  Please read TelemetryLog.h
+ *
+ */
+void TelemetryLogInit()
+{
+    ForgetHistory();
+    logPackedSize = 0;
+}
+
+int TelemetryLogFlush(MB85RS &fram)
+{
+    int result;
+
+    if (logPackedSize == 0)
+    {
+        return FRAM_OPERATION_SUCCESS;
+    }
+
+    result = OBCFramLogAppend(fram, logPackedTime, TELEMETRYLOG_ID, logPacked, logPackedSize);
+    logPackedSize = 0;
+    if (result != FRAM_OPERATION_SUCCESS)
+    {
+        ForgetHistory();
+        return FRAM_NOT_AVAILABLE;
+    }
+    return FRAM_OPERATION_SUCCESS;
+}
+
+int TelemetryLogAppend(MB85RS &fram, unsigned long time, unsigned char id, unsigned char *sample, int size)
+{
+    static unsigned char entry[TELEMETRYLOG_ENTRY_HEADER + TELEMETRYCODEC_MAX_SIZE(TELEMETRYLOG_MAX_SAMPLE)];
+    TelemetryLogHistory *history;
+    bool keyFrame;
+    int length;
+    int result = FRAM_OPERATION_SUCCESS;
+
+    if ((size <= 0) || (size > TELEMETRYLOG_MAX_SAMPLE) || (id & TELEMETRYLOG_KEY_FRAME))
+    {
+        return FRAM_WRONG_SIZE;
+    }
+
+    // The samples of a record have the same time
+    if ((logPackedSize > 0) && (time != logPackedTime))
+    {
+        result = TelemetryLogFlush(fram);
+    }
+
+    history = GetHistory(id);
+    keyFrame = (history == 0) || (history->size != size) || (history->sinceKeyFrame >= TELEMETRYLOG_KEY_PERIOD);
+    length = TelemetryEncode(keyFrame ? 0 : history->sample, sample, size,
+                             &entry[TELEMETRYLOG_ENTRY_HEADER], sizeof(entry) - TELEMETRYLOG_ENTRY_HEADER);
+
+    if (logPackedSize + TELEMETRYLOG_ENTRY_HEADER + length > OBCFRAM_LOG_MAX_PAYLOAD)
+    {
+        if (TelemetryLogFlush(fram) != FRAM_OPERATION_SUCCESS)
+        {
+            // The previous sample is lost with the record
+            result = FRAM_NOT_AVAILABLE;
+            history = GetHistory(id);
+            keyFrame = true;
+            length = TelemetryEncode(0, sample, size,
+                                     &entry[TELEMETRYLOG_ENTRY_HEADER], sizeof(entry) - TELEMETRYLOG_ENTRY_HEADER);
+        }
+    }
+
+    entry[0] = id | (keyFrame ? TELEMETRYLOG_KEY_FRAME : 0);
+    entry[1] = size;
+    entry[2] = length;
+    memcpy(&logPacked[logPackedSize], entry, TELEMETRYLOG_ENTRY_HEADER + length);
+    logPackedSize += TELEMETRYLOG_ENTRY_HEADER + length;
+    logPackedTime = time;
+
+    if (history != 0)
+    {
+        memcpy(history->sample, sample, size);
+        history->size = size;
+        history->sinceKeyFrame = keyFrame ? 1 : history->sinceKeyFrame + 1;
+    }
+    return result;
+}
+
+int TelemetryLogNext(unsigned char *payload, int size, int offset, unsigned char *id, bool *keyFrame,
+                     int *sampleSize, unsigned char **encoded, int *length)
+{
+    if (offset + TELEMETRYLOG_ENTRY_HEADER > size)
+    {
+        return TELEMETRYCODEC_ERROR;
+    }
+
+    *id = payload[offset] & ~TELEMETRYLOG_KEY_FRAME;
+    *keyFrame = (payload[offset] & TELEMETRYLOG_KEY_FRAME) != 0;
+    *sampleSize = payload[offset + 1];
+    *length = payload[offset + 2];
+    *encoded = &payload[offset + TELEMETRYLOG_ENTRY_HEADER];
+
+    if (offset + TELEMETRYLOG_ENTRY_HEADER + *length > size)
+    {
+        return TELEMETRYCODEC_ERROR;
+    }
+    return offset + TELEMETRYLOG_ENTRY_HEADER + *length;
+}
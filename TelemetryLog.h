@@ -0,0 +1,107 @@
+/*
+ *  TelemetryLog.h
+ *
+ *  Telemetry history stored compressed in the FRAM log (OBCFramLog.h). Every
+ *  sample of a container is encoded against the previous logged sample of the
+ *  same container (TelemetryCodec.h), and the samples of a tick are packed in as
+ *  few records as possible. The records keep their fixed size, so the binary
+ *  searches of the log and the copy to the SD card are unchanged.
+ *
+ *  Packed record: container ID TELEMETRYLOG_ID, the payload is a sequence of
+ *      + 0                 ID of the container, | TELEMETRYLOG_KEY_FRAME for a key frame
+ *      + 1                 Size of the sample
+ *      + 2                 Length of the encoded sample
+ *      + 3~                The encoded sample
+ *
+ *  A sample which isn't a key frame can only be decoded after the previous sample
+ *  of its container. A container is logged as a key frame after every
+ *  TELEMETRYLOG_KEY_PERIOD samples, after a reset and after a failed append, so a
+ *  lost or overwritten record (a gap in the sequence numbers, or a record which
+ *  fails its CRC) only stops the decoding until the next key frame.
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef TELEMETRYLOG_H_
+#define TELEMETRYLOG_H_
+
+#include "MB85RS.h"
+#include "OBCFramLog.h"
+#include "TelemetryCodec.h"
+
+#define TELEMETRYLOG_ID             0xFF    // Container ID of the packed records in the FRAM log
+#define TELEMETRYLOG_KEY_FRAME      0x80    // Flag of the ID of a sample encoded without the previous one
+#define TELEMETRYLOG_KEY_PERIOD     10      // Samples of a container between two key frames
+#define TELEMETRYLOG_CONTAINERS     6       // Containers with a previous sample
+#define TELEMETRYLOG_MAX_SAMPLE     96      // Largest container
+#define TELEMETRYLOG_ENTRY_HEADER   3
+
+/**
+ *
+ *  Forget the previous samples (the next sample of every container is a key frame),
+ *  call it after OBCFramLogInit()
+ *
+ */
+void TelemetryLogInit();
+
+/**
+ *
+ *  Add a sample to the packed record of the tick. The record is appended to the
+ *  FRAM log when the sample doesn't fit in it anymore or when the time changes.
+ *
+ *  Parameter:
+ *      MB85RS &fram                    The FRAM object
+ *      unsigned long time              Time of the sample (it should never decrease)
+ *      unsigned char id                ID of the container (its bus address, below 0x80)
+ *      unsigned char *sample           The telemetry array
+ *      int size                        The size of the array (at most TELEMETRYLOG_MAX_SAMPLE)
+ *
+ *  Returns:
+ *      TelemetryLogAppend()            FRAM_NOT_AVAILABLE (a full record couldn't be appended) or
+ *                                      FRAM_OPERATION_SUCCESS or
+ *                                      FRAM_WRONG_SIZE
+ *
+ */
+int TelemetryLogAppend(MB85RS &fram, unsigned long time, unsigned char id, unsigned char *sample, int size);
+
+/**
+ *
+ *  Append the packed record of the tick to the FRAM log
+ *
+ *  Parameter:
+ *      MB85RS &fram                    The FRAM object
+ *
+ *  Returns:
+ *      TelemetryLogFlush()             FRAM_NOT_AVAILABLE or
+ *                                      FRAM_OPERATION_SUCCESS (also when there was nothing to append)
+ *
+ */
+int TelemetryLogFlush(MB85RS &fram);
+
+/**
+ *
+ *  Parse a sample of a packed record, for the ground software and the tests. The
+ *  sample is then decoded with TelemetryDecode(), against the previous sample of
+ *  the same container unless it's a key frame.
+ *
+ *  Parameter:
+ *      unsigned char *payload          The payload of the record (see OBCFramLogRead())
+ *      int size                        The size of the payload
+ *      int offset                      Offset of the sample (0: the first one)
+ *
+ *  Returns:
+ *      TelemetryLogNext()              Offset of the next sample,
+ *                                      size after the last sample or
+ *                                      TELEMETRYCODEC_ERROR (the payload is corrupted)
+ *      unsigned char *id               ID of the container
+ *      bool *keyFrame                  true if the sample is a key frame
+ *      int *sampleSize                 Size of the sample
+ *      unsigned char **encoded         The encoded sample (in payload)
+ *      int *length                     Length of the encoded sample
+ *
+ */
+int TelemetryLogNext(unsigned char *payload, int size, int offset, unsigned char *id, bool *keyFrame,
+                     int *sampleSize, unsigned char **encoded, int *length);
+
+#endif /* TELEMETRYLOG_H_ */
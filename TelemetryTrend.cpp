@@ -0,0 +1,174 @@
+/*
+ *  TelemetryTrend.cpp
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "TelemetryTrend.h"
+
+static_assert((TREND_SAMPLES & (TREND_SAMPLES - 1)) == 0, "TREND_SAMPLES must be a power of 2");
+
+// Struct of arrays: every series is contiguous
+signed short trendValues[TREND_SERIES][TREND_SAMPLES];
+unsigned long trendTimes[TREND_SAMPLES];
+unsigned int trendNext;         // Index of the next sample (wraps around)
+int trendCount;
+
+/**
+ *
+ *  Please read TelemetryTrend.h
+ *
+ */
+void TrendAppend(unsigned long time, const signed short *values)
+{
+    unsigned int index = trendNext & (TREND_SAMPLES - 1);
+
+    for (int i = 0; i < TREND_SERIES; i++)
+    {
+        trendValues[i][index] = values[i];
+    }
+    trendTimes[index] = time;
+
+    trendNext++;
+    if (trendCount < TREND_SAMPLES)
+    {
+        trendCount++;
+    }
+}
+
+int TrendCount()
+{
+    return trendCount;
+}
+
+/**
+ *
+ *  The window as at most two contiguous runs of the ring: [first, first + length)
+ *  then [0, window - length)
+ *
+ */
+int TrendWindow(int *window, unsigned int *first)
+{
+    if (*window > trendCount)
+    {
+        *window = trendCount;
+    }
+    if (*window < 0)
+    {
+        *window = 0;
+    }
+
+    *first = (trendNext - *window) & (TREND_SAMPLES - 1);
+    return (*first + *window > TREND_SAMPLES) ? (TREND_SAMPLES - *first) : *window;
+}
+
+signed short TrendMin(TrendSeries series, int window)
+{
+    unsigned int first;
+    int length = TrendWindow(&window, &first);
+    const signed short *values = trendValues[series];
+    signed short min = 0x7FFF;
+    int i;
+
+    if (window == 0)
+    {
+        return 0;
+    }
+    for (i = 0; i < length; i++)
+    {
+        min = (values[first + i] < min) ? values[first + i] : min;
+    }
+    for (i = 0; i < window - length; i++)
+    {
+        min = (values[i] < min) ? values[i] : min;
+    }
+    return min;
+}
+
+signed short TrendMax(TrendSeries series, int window)
+{
+    unsigned int first;
+    int length = TrendWindow(&window, &first);
+    const signed short *values = trendValues[series];
+    signed short max = -0x8000;
+    int i;
+
+    if (window == 0)
+    {
+        return 0;
+    }
+    for (i = 0; i < length; i++)
+    {
+        max = (values[first + i] > max) ? values[first + i] : max;
+    }
+    for (i = 0; i < window - length; i++)
+    {
+        max = (values[i] > max) ? values[i] : max;
+    }
+    return max;
+}
+
+float TrendMean(TrendSeries series, int window)
+{
+    unsigned int first;
+    int length = TrendWindow(&window, &first);
+    const signed short *values = trendValues[series];
+    long sum = 0;
+    int i;
+
+    if (window == 0)
+    {
+        return 0;
+    }
+    for (i = 0; i < length; i++)
+    {
+        sum += values[first + i];
+    }
+    for (i = 0; i < window - length; i++)
+    {
+        sum += values[i];
+    }
+    return (float)sum / window;
+}
+
+float TrendSlope(TrendSeries series, int window)
+{
+    unsigned int first;
+    int length = TrendWindow(&window, &first);
+    const signed short *values = trendValues[series];
+    unsigned long newest = trendTimes[(trendNext - 1) & (TREND_SAMPLES - 1)];
+    float t, sumT = 0, sumV = 0, sumTT = 0, sumTV = 0;
+    float denominator;
+    int i;
+
+    if (window < 2)
+    {
+        return 0;
+    }
+
+    // Times relative to the newest sample, so the sums stay small
+    for (i = 0; i < length; i++)
+    {
+        t = -(float)(newest - trendTimes[first + i]);
+        sumT += t;
+        sumV += values[first + i];
+        sumTT += t * t;
+        sumTV += t * values[first + i];
+    }
+    for (i = 0; i < window - length; i++)
+    {
+        t = -(float)(newest - trendTimes[i]);
+        sumT += t;
+        sumV += values[i];
+        sumTT += t * t;
+        sumTV += t * values[i];
+    }
+
+    denominator = window * sumTT - sumT * sumT;
+    if (denominator == 0)
+    {
+        return 0;
+    }
+    return (window * sumTV - sumT * sumV) / denominator;
+}
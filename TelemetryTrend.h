@@ -0,0 +1,71 @@
+/*
+ *  TelemetryTrend.h
+ *
+ *  Short history of a few telemetry values in RAM, for trend analysis on board
+ *  (e.g. the slope of the battery voltage before it reaches the safe mode
+ *  threshold).
+ *
+ *  The samples are kept in a ring of TREND_SAMPLES entries, one array per series
+ *  (struct of arrays): a reduction over a series runs on contiguous values
+ *  (at most two runs when the window wraps around), without branches in the loops.
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef TELEMETRYTREND_H_
+#define TELEMETRYTREND_H_
+
+#define TREND_SAMPLES       64      // 64 * (4 + 2 * TREND_SERIES) bytes of RAM
+#define TREND_PERIOD        10      // Seconds between two samples in StateMachine() (about 10 min of history)
+
+// The series, in the order of the values given to TrendAppend()
+typedef enum TrendSeries
+{
+    TREND_BATT_VOLTAGE,     // EPSTelemetryContainer::getBattVoltage() (mV)
+    TREND_BATT_CURRENT,     // EPSTelemetryContainer::getBattCurrent()
+    TREND_BUS_VOLTAGE,      // OBCTelemetryContainer::getBusVoltage() (mV) of hk.getTelemetry()
+    TREND_TEMPERATURE,      // OBCTelemetryContainer::getTemperature() of hk.getTelemetry()
+    TREND_SERIES
+} TrendSeries;
+
+/**
+ *
+ *  Append a sample of every series, the oldest one is dropped when the ring is full
+ *
+ *  Parameters:
+ *      unsigned long time              Time of the sample (e.g. stateMachineTime)
+ *      signed short *values            A value for every series (TREND_SERIES values)
+ *
+ */
+void TrendAppend(unsigned long time, const signed short *values);
+
+/**
+ *
+ *  Returns:
+ *      TrendCount()                    Number of samples in the ring (at most TREND_SAMPLES)
+ *
+ */
+int TrendCount();
+
+/**
+ *
+ *  Reductions over the last samples of a series
+ *
+ *  Parameters:
+ *      TrendSeries series              The series
+ *      int window                      Number of samples (the newest ones), limited
+ *                                      to TrendCount()
+ *  Returns:
+ *      TrendMin() / TrendMax()         Smallest / largest value (0 without samples)
+ *      TrendMean()                     Average value (0 without samples)
+ *      TrendSlope()                    Least-squares slope in units per second
+ *                                      (0 with less than 2 samples)
+ *
+ */
+signed short TrendMin(TrendSeries series, int window);
+signed short TrendMax(TrendSeries series, int window);
+float TrendMean(TrendSeries series, int window);
+float TrendSlope(TrendSeries series, int window);
+
+#endif /* TELEMETRYTREND_H_ */
@@ -0,0 +1,135 @@
+/*
+ *  TimeoutEstimator.cpp
+ *
+ *  The estimation uses fixed-point values (RFC 6298):
+ *      srtt8   = 8 * smoothed RTT
+ *      rttvar4 = 4 * RTT variation
+ *  so the time limit is srtt8 / 8 + rttvar4, shifted left by the backoff.
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "TimeoutEstimator.h"
+
+typedef struct ServiceTimeout
+{
+    Address destination;                // 0: free entry
+    unsigned char serviceNum;
+    unsigned long srtt8;                // 0: no reply measured yet
+    unsigned long rttvar4;
+    unsigned char backoff;
+    unsigned long floorMS;
+    unsigned long ceilingMS;
+} ServiceTimeout;
+
+ServiceTimeout timeouts[TIMEOUT_TABLE_SIZE];
+
+// Used when the table is full: it is reset at every use, so it never has an estimation
+ServiceTimeout untracked;
+
+ServiceTimeout &GetServiceTimeout(Address destination, unsigned char serviceNum)
+{
+    ServiceTimeout *entry = 0;
+
+    for (int i = 0; i < TIMEOUT_TABLE_SIZE; i++)
+    {
+        if ((timeouts[i].destination == destination) && (timeouts[i].serviceNum == serviceNum))
+        {
+            return timeouts[i];
+        }
+        if ((entry == 0) && (timeouts[i].destination == 0))
+        {
+            entry = &timeouts[i];
+        }
+    }
+
+    if (entry == 0)
+    {
+        entry = &untracked;
+        entry->srtt8 = 0;
+    }
+
+    // The limits are set the first time an entry is used
+    entry->destination = destination;
+    entry->serviceNum = serviceNum;
+    entry->rttvar4 = 0;
+    entry->backoff = 0;
+    entry->floorMS = TIMEOUT_DEFAULT_FLOOR_MS;
+    entry->ceilingMS = TIMEOUT_DEFAULT_CEILING_MS;
+    return *entry;
+}
+
+void TimeoutSetLimits(Address destination, unsigned char serviceNum, unsigned long floorMS, unsigned long ceilingMS)
+{
+    ServiceTimeout &entry = GetServiceTimeout(destination, serviceNum);
+
+    entry.floorMS = (floorMS > 0) ? floorMS : 1;
+    entry.ceilingMS = (ceilingMS > entry.floorMS) ? ceilingMS : entry.floorMS;
+}
+
+unsigned long TimeoutGetLimit(Address destination, unsigned char serviceNum, unsigned long maxMS)
+{
+    ServiceTimeout &entry = GetServiceTimeout(destination, serviceNum);
+    unsigned long limit;
+
+    // No reply measured yet: wait as long as the caller allows
+    if (entry.srtt8 == 0)
+    {
+        return maxMS;
+    }
+
+    limit = ((entry.srtt8 >> 3) + entry.rttvar4) << entry.backoff;
+
+    if (limit < entry.floorMS)
+    {
+        limit = entry.floorMS;
+    }
+    if (limit > entry.ceilingMS)
+    {
+        limit = entry.ceilingMS;
+    }
+    return (limit < maxMS) ? limit : maxMS;
+}
+
+void TimeoutUpdate(Address destination, unsigned char serviceNum, unsigned long rttMS)
+{
+    ServiceTimeout &entry = GetServiceTimeout(destination, serviceNum);
+    long error;
+
+    // The RTT is measured with a 1ms tick
+    if (rttMS == 0)
+    {
+        rttMS = 1;
+    }
+
+    if (entry.srtt8 == 0)
+    {
+        // First measurement
+        entry.srtt8 = rttMS << 3;
+        entry.rttvar4 = rttMS << 1;
+    }
+    else
+    {
+        // srtt = 7/8 srtt + 1/8 rtt, rttvar = 3/4 rttvar + 1/4 |srtt - rtt|
+        error = (long)rttMS - (long)(entry.srtt8 >> 3);
+        entry.srtt8 += error;
+        if (error < 0)
+        {
+            error = -error;
+        }
+        entry.rttvar4 = entry.rttvar4 + error - (entry.rttvar4 >> 2);
+    }
+
+    entry.backoff = 0;
+}
+
+void TimeoutExpired(Address destination, unsigned char serviceNum)
+{
+    ServiceTimeout &entry = GetServiceTimeout(destination, serviceNum);
+
+    if (entry.backoff < TIMEOUT_MAX_BACKOFF)
+    {
+        entry.backoff++;
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ *  TimeoutEstimator.h
+ *
+ *  Estimates the time limit of a request from the measured round-trip time
+ *  of each service of each module (smoothed RTT plus 4 times its variation,
+ *  like TCP), so a slow command doesn't share the estimation of housekeeping.
+ *  A service which doesn't reply doubles its time limit, up to the ceiling.
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef TIMEOUTESTIMATOR_H_
+#define TIMEOUTESTIMATOR_H_
+
+#include "Communication.h"
+
+#define TIMEOUT_DEFAULT_FLOOR_MS    10
+#define TIMEOUT_DEFAULT_CEILING_MS  1000
+#define TIMEOUT_MAX_BACKOFF         4   // The time limit is doubled at most 4 times
+#define TIMEOUT_TABLE_SIZE          16  // Services estimated at once (destination, service number)
+
+/**
+ *
+ *  Set the range of the time limit of a service of a module
+ *
+ *  Parameters:
+ *      Address destination             Address of the target board except OBC
+ *      unsigned char serviceNum        Service number (first byte of the payload)
+ *      unsigned long floorMS           The time limit is never shorter than floorMS
+ *      unsigned long ceilingMS         The time limit is never longer than ceilingMS
+ *
+ */
+void TimeoutSetLimits(Address destination, unsigned char serviceNum, unsigned long floorMS, unsigned long ceilingMS);
+
+/**
+ *
+ *  Get the time limit of the next request to a service of a module
+ *
+ *  Parameters:
+ *      Address destination             Address of the target board except OBC
+ *      unsigned char serviceNum        Service number (first byte of the payload)
+ *      unsigned long maxMS             Worst-case time limit accepted by the caller
+ *  Returns:
+ *      TimeoutGetLimit()               The time limit in ms: maxMS until the service has replied once
+ *                                      (or when the table is full), then the estimation (never
+ *                                      more than maxMS)
+ *
+ */
+unsigned long TimeoutGetLimit(Address destination, unsigned char serviceNum, unsigned long maxMS);
+
+/**
+ *
+ *  Update the estimation with a measured round-trip time
+ *
+ *  Parameters:
+ *      Address destination             Address of the module which replied
+ *      unsigned char serviceNum        Service number of the request
+ *      unsigned long rttMS             Time between the request and the reply
+ *
+ */
+void TimeoutUpdate(Address destination, unsigned char serviceNum, unsigned long rttMS);
+
+/**
+ *
+ *  Back off after a request without reply
+ *
+ *  Parameters:
+ *      Address destination             Address of the module which didn't reply
+ *      unsigned char serviceNum        Service number of the request
+ *
+ */
+void TimeoutExpired(Address destination, unsigned char serviceNum);
+
+#endif /* TIMEOUTESTIMATOR_H_ */
@@ -8,6 +8,9 @@ TMP100 temp(I2Cinternal, 0x48);
 // SPI bus
 DSPI spi(3);
 MB85RS fram(spi, GPIO_PORT_P1, GPIO_PIN0, true);
+#ifdef SDCARD_ENABLED
+SDCard sdCard(spi, SDCARD_CS_PORT, SDCARD_CS_PIN); // Chip select from the build options, see SDCardAccess.h
+#endif
 
 // HardwareMonitor
 HWMonitor hwMonitor(&fram);
@@ -21,6 +24,12 @@ PQ9Bus pq9bus(3, GPIO_PORT_P9, GPIO_PIN0);
 // services running in the system
 ResetService reset( GPIO_PORT_P4, GPIO_PIN0);
 HousekeepingService<OBCTelemetryContainer> hk;
+PingService ping;
+SoftwareUpdateService SWupdate(fram);
+Service* services[] = { &ping, &reset, &hk, &SWupdate };
+
+// OBC command handler: the requests from the other modules are passed to the services
+CommandHandler<PQ9Frame, PQ9Message> cmdHandler(pq9bus, services, 4);
 
 // Data containers in OBC
 OBCTelemetryContainer OBCContainer;
@@ -32,10 +41,27 @@ PROPTelemetryContainer PROPContainer;
 
 // OBC board tasks
 PeriodicTask stateMachineTask(1000, StateMachine, StateMachineInit);
-// PeriodicTask SDCardTask(10000, SDCardAccess); // TODO
+Task communicationTask(CommunicationPoll);
+#ifdef SDCARD_ENABLED
+PeriodicTask SDCardTask(10000, SDCardAccess, SDCardInit);
+PeriodicTask* periodicTasks[] = {&stateMachineTask, &SDCardTask};
+Task* tasks[] = { &stateMachineTask, &communicationTask, &cmdHandler, &SDCardTask };
+#else
 PeriodicTask* periodicTasks[] = {&stateMachineTask};
-PeriodicTaskNotifier taskNotifier = PeriodicTaskNotifier(periodicTasks, 1);
-Task* tasks[] = { &stateMachineTask };
+Task* tasks[] = { &stateMachineTask, &communicationTask, &cmdHandler };
+#endif
+PeriodicTaskNotifier taskNotifier = PeriodicTaskNotifier(periodicTasks, sizeof(periodicTasks) / sizeof(periodicTasks[0]));
+
+// callbacks of the command handler (the lambda functions don't build in CCS, see main())
+void receivedRequest(DataFrame &newFrame)
+{
+    cmdHandler.received(newFrame);
+}
+
+void validCmd(void)
+{
+    reset.kickInternalWatchDog();
+}
 
 void acquireTelemetry(OBCTelemetryContainer *tc)
 {
@@ -79,6 +105,9 @@ void main(void)
     spi.initMaster(DSPI::MODE0, DSPI::MSBFirst, 1000000);
     fram.init();
 
+    // select the CRC-32 implementation for the FRAM (CRC32 module or table)
+    ChecksumInit();
+
     // initialize the shunt resistor
     powerBus.setShuntResistor(40);
 
@@ -106,16 +135,20 @@ void main(void)
     hwMonitor.readResetStatus();
     hwMonitor.readCSStatus();
 
-    // link the command handler to the PQ9 bus:
-    // every time a new command is received, it will be forwarded to the command handler
-    // TODO: put back the lambda function after bug in CCS has been fixed
-    //pq9bus.setReceiveHandler([](PQ9Frame &newFrame){ cmdHandler.received(newFrame); });
-    pq9bus.setReceiveHandler(&receivedCommand);
+    // initialize the request engine:
+    // - Timer32_1 interrupt for the time limit of the requests
+    // - command handler answering the requests from the other modules
+    CommunicationInit();
+    CommunicationSetRequestHandler(&receivedRequest);
 
     // every time a command is correctly processed, call the watch-dog
     // TODO: put back the lambda function after bug in CCS has been fixed
     //cmdHandler.onValidCommand([]{ reset.kickInternalWatchDog(); });
-    //cmdHandler.onValidCommand(&validCmd);
+    cmdHandler.onValidCommand(&validCmd);
+
+    // link the request engine to the PQ9 bus:
+    // every frame received (replies and requests) is queued and communicationTask is notified
+    pq9bus.setReceiveHandler(&receivedCommand);
 
     Console::log("OBC booting...SLOT: %d", (int) Bootloader::getCurrentSlot());
 
@@ -123,5 +156,5 @@ void main(void)
         Console::log("SW_VERSION: %s", (const char*)xtr(SW_VERSION));
     }
 
-    TaskManager::start(tasks, 1);
+    TaskManager::start(tasks, sizeof(tasks) / sizeof(tasks[0]));
 }
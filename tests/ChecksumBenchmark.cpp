@@ -0,0 +1,138 @@
+/*
+ *  ChecksumBenchmark.cpp
+ *
+ *  Host benchmark of ChecksumCRC32() (Checksum.cpp runs as is, with its table:
+ *  the CRC32 module exists only on the MSP432) against the bit-by-bit CRC-32
+ *  it replaces, on the telemetry of a tick (TICK_BYTES, the six containers)
+ *  and on a single FRAM slot.
+ *
+ *  The cycles are the time stamp counter of the host (rdtsc on x86, else the
+ *  time at a nominal HOST_HZ), so the bytes per cycle compare the two kernels
+ *  on the same core; they aren't the cycles of the Cortex-M4.
+ *
+ *  Checks: the CRC of "123456789", and the same result as the bit-by-bit CRC
+ *  on random blocks, in one part or in two.
+ *
+ *  Build and run from the root of the repository:
+ *      g++ -std=c++14 -O2 -Itests/stubs -I. tests/ChecksumBenchmark.cpp Checksum.cpp
+ *          -o checksum_benchmark && ./checksum_benchmark
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "Checksum.h"
+#include "driverlib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define TICK_BYTES          330     // Telemetry of the six containers in a tick
+#define SLOT_BYTES          96      // Largest FRAM slot (EPS)
+#define BENCH_RUNS          200000
+#define CHECK_BLOCKS        10000
+#define HOST_HZ             1000000000.0
+
+// driverlib stand-ins (the table is used without ChecksumInit())
+void MAP_CRC32_setSeed(uint32_t, uint_fast8_t) {}
+void MAP_CRC32_set8BitData(uint8_t, uint_fast8_t) {}
+uint32_t MAP_CRC32_getResult(uint_fast8_t) { return 0; }
+uint32_t MAP_CRC32_getResultReversed(uint_fast8_t) { return 0; }
+
+typedef unsigned long (*Kernel)(unsigned long crc, unsigned char *data, int size);
+
+/**
+ *
+ *  CRC-32 bit by bit (reflected polynomial 0xEDB88320), the reference
+ *
+ */
+unsigned long BitwiseCRC32(unsigned long crc, unsigned char *data, int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (unsigned long)-(long)(crc & 1));
+        }
+    }
+    return crc & 0xFFFFFFFF;
+}
+
+unsigned long long Cycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)((now.tv_sec + now.tv_nsec * 1e-9) * HOST_HZ);
+#endif
+}
+
+void Measure(const char *name, Kernel kernel, unsigned char *data, int size)
+{
+    volatile unsigned long sink = 0;
+    unsigned long long start, cycles;
+    struct timespec begin, end;
+    double seconds;
+
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    start = Cycles();
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        data[0] = run;
+        sink = sink ^ kernel(CHECKSUM_CRC32_INIT, data, size);
+    }
+    cycles = Cycles() - start;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    seconds = (end.tv_sec - begin.tv_sec) + (end.tv_nsec - begin.tv_nsec) * 1e-9;
+
+    printf("    %-12s %4d bytes: %6.3f bytes per cycle, %7.1f cycles and %6.3f us per block\n", name, size,
+           (double)size * BENCH_RUNS / cycles, (double)cycles / BENCH_RUNS, seconds * 1e6 / BENCH_RUNS);
+}
+
+int main()
+{
+    static unsigned char data[TICK_BYTES];
+    unsigned char check[] = "123456789";
+    int failures = 0;
+    int size, split;
+
+    // The check value, then random blocks in one or two parts
+    if ((ChecksumCRC32(CHECKSUM_CRC32_INIT, check, 9) != 0x340BC6D9)
+        || (BitwiseCRC32(CHECKSUM_CRC32_INIT, check, 9) != 0x340BC6D9))
+    {
+        failures++;
+    }
+    for (int i = 0; i < CHECK_BLOCKS; i++)
+    {
+        size = 1 + rand() % TICK_BYTES;
+        split = rand() % size;
+        for (int j = 0; j < size; j++)
+        {
+            data[j] = rand();
+        }
+        if ((ChecksumCRC32(CHECKSUM_CRC32_INIT, data, size) != BitwiseCRC32(CHECKSUM_CRC32_INIT, data, size))
+            || (ChecksumCRC32(ChecksumCRC32(CHECKSUM_CRC32_INIT, data, split), &data[split], size - split)
+                != BitwiseCRC32(CHECKSUM_CRC32_INIT, data, size)))
+        {
+            failures++;
+        }
+    }
+    printf("%d random blocks checked against the bit-by-bit CRC, %d failures\n", CHECK_BLOCKS, failures);
+
+    printf("CRC-32 kernels (%d runs)\n", BENCH_RUNS);
+    Measure("table", ChecksumCRC32, data, TICK_BYTES);
+    Measure("bit by bit", BitwiseCRC32, data, TICK_BYTES);
+    Measure("table", ChecksumCRC32, data, SLOT_BYTES);
+    Measure("bit by bit", BitwiseCRC32, data, SLOT_BYTES);
+
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+    return (failures == 0) ? 0 : 1;
+}
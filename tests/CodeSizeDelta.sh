@@ -0,0 +1,74 @@
+#!/bin/sh
+#
+#  CodeSizeDelta.sh
+#
+#  Code size of the telemetry paths before and after the containers resolved
+#  size() and getArray() at compile time (by default the commit which added
+#  TelemetrySweepSlotOf(), against its parent). Both trees are built with the
+#  same compiler and the host stand-ins of tests/stubs:
+#      the six containers              their .cpp
+#      the container objects           a unit which defines them like main.cpp,
+#                                      it gets the vtables and the inline methods
+#      the request engine              Communication.cpp
+#  StateMachine.cpp needs the DelfiPQcore headers (OBC.h), so it isn't counted.
+#
+#  Run from the root of the repository, on the host:
+#      sh tests/CodeSizeDelta.sh [commit]
+#  or for the Cortex-M4 of the MSP432:
+#      CXX=arm-none-eabi-g++ SIZE=arm-none-eabi-size CXXFLAGS="-mcpu=cortex-m4 -mthumb -Os"
+#          sh tests/CodeSizeDelta.sh [commit]
+#
+#  Created on: 17 Oct 2026
+#      Author: agent
+#
+
+set -e
+
+COMMIT=${1:-$(git log -S TelemetrySweepSlotOf --format=%H -- Communication.h | tail -n 1)}
+CXX=${CXX:-g++}
+SIZE=${SIZE:-size}
+CXXFLAGS=${CXXFLAGS:--Os}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+CONTAINERS="ADB ADCS COMMS EPS PROP OBC"
+
+# The request engine of these commits still took the service table of DelfiPQcore
+mkdir "$WORK/stubs"
+cat > "$WORK/stubs/Service.h" << 'EOF'
+#include "DataFrame.h"
+class Service
+{
+public:
+    virtual bool process(DataFrame &command, DataFrame &workingBuffer) = 0;
+};
+EOF
+
+for tree in before after; do
+    if [ "$tree" = before ]; then REVISION="$COMMIT^"; else REVISION="$COMMIT"; fi
+    mkdir "$WORK/$tree"
+    git archive "$REVISION" | tar -x -C "$WORK/$tree"
+
+    OBJECTS=""
+    echo "#include \"Communication.h\"" > "$WORK/$tree/Objects.cpp"
+    for name in $CONTAINERS; do
+        echo "#include \"${name}TelemetryContainer.h\"" >> "$WORK/$tree/Objects.cpp"
+        echo "${name}TelemetryContainer ${name}Container;" >> "$WORK/$tree/Objects.cpp"
+        OBJECTS="$OBJECTS ${name}TelemetryContainer"
+    done
+    for unit in $OBJECTS Objects Communication; do
+        $CXX -std=c++14 $CXXFLAGS -c -Itests/stubs -I"$WORK/stubs" -I"$WORK/$tree" "$WORK/$tree/$unit.cpp" \
+            -o "$WORK/$tree/$unit.o"
+    done
+done
+
+echo "CodeSizeDelta: $CXX $CXXFLAGS, $COMMIT against its parent"
+for unit in ADBTelemetryContainer ADCSTelemetryContainer COMMSTelemetryContainer EPSTelemetryContainer \
+            PROPTelemetryContainer OBCTelemetryContainer Objects Communication; do
+    BEFORE=$($SIZE "$WORK/before/$unit.o" | awk 'NR == 2 {print $1 + $2}')
+    AFTER=$($SIZE "$WORK/after/$unit.o" | awk 'NR == 2 {print $1 + $2}')
+    printf "    %-26s %6d -> %6d bytes (text + data), %+d\n" "$unit" "$BEFORE" "$AFTER" $((AFTER - BEFORE))
+done
+BEFORE=$($SIZE "$WORK"/before/*.o | awk 'NR > 1 {sum += $1 + $2} END {print sum}')
+AFTER=$($SIZE "$WORK"/after/*.o | awk 'NR > 1 {sum += $1 + $2} END {print sum}')
+printf "    %-26s %6d -> %6d bytes (text + data), %+d\n" "total" "$BEFORE" "$AFTER" $((AFTER - BEFORE))
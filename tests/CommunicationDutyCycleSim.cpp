@@ -0,0 +1,142 @@
+/*
+ *  CommunicationDutyCycleSim.cpp
+ *
+ *  Host measurement of the CPU duty cycle of the bus traffic of a StateMachine()
+ *  tick (Communication.cpp runs as is on the simulated bus of SimulatedBus.h):
+ *  the housekeeping sweep of the five modules, then the four power lines set
+ *  one by one with RequestReplyRetry().
+ *
+ *  The CPU is awake while it transmits, and for SIM_WAKEUP_US every time an
+ *  interrupt wakes it up from LPM0 (the 1ms tick or a received frame: the ISR
+ *  and CommunicationPoll()). The time of the code itself isn't simulated, so
+ *  SIM_WAKEUP_US is an estimate to adjust once it's measured on the target.
+ *  The polling engine of the baseline (TransmitWithTimeLimit()) spun on the
+ *  timer for the whole time, so its duty cycle is the bus time of the tick.
+ *  The replies of the power commands are checked: they are copied to the buffer
+ *  given to RequestReplyRetry().
+ *
+ *  Build and run from the root of the repository:
+ *      g++ -std=c++14 -O2 -Itests/stubs -I. -Itests tests/CommunicationDutyCycleSim.cpp
+ *          tests/SimulatedBus.cpp Communication.cpp TimeoutEstimator.cpp DirtyLines.cpp
+ *          -o duty_cycle_sim && ./duty_cycle_sim
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "SimulatedBus.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SIM_TICKS               5000
+#define SIM_TICK_PERIOD_MS      1000    // Period of stateMachineTask
+#define SIM_WAKEUP_US           20      // CPU time of a wake-up (about 1000 cycles at 48MHz)
+
+const SimModule simModules[] = {
+    // address, telemetry, fast delay, slow tail, loss
+    {ADB,   26, 3, 15, 10, 20, 90, 3},
+    {ADCS,  26, 3, 15, 10, 20, 90, 3},
+    {COMMS, 66, 3, 15, 10, 20, 90, 3},
+    {EPS,   87, 3, 15, 10, 20, 90, 1},
+    {PROP,  26, 3, 15, 10, 20, 90, 3}
+};
+
+unsigned char simArrays[5][96];
+
+int CompareDuty(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+void PrintDuty(const char *name, double *samples, int count)
+{
+    double sum = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        sum += samples[i];
+    }
+    qsort(samples, count, sizeof(double), CompareDuty);
+    printf("    %-18s mean %6.2f%%  p50 %6.2f%%  p99 %6.2f%%  max %6.2f%%\n", name,
+           100 * sum / count, 100 * samples[count / 2], 100 * samples[count * 99 / 100], 100 * samples[count - 1]);
+}
+
+int main()
+{
+    static double engineDuty[SIM_TICKS];
+    static double pollingDuty[SIM_TICKS];
+    unsigned long tickStart, awake, wakeUps, busMS, frames = 0, totalWakeUps = 0;
+    int wrongReplies = 0, staleReplies = 0;
+    unsigned char payload[4];
+    unsigned char reply[4];
+    unsigned int replySize;
+
+    SimReset();
+    for (unsigned int i = 0; i < sizeof(simModules) / sizeof(simModules[0]); i++)
+    {
+        SimAddModule(simModules[i]);
+    }
+    CommunicationInit();
+
+    for (int tick = 0; tick < SIM_TICKS; tick++)
+    {
+        TelemetrySweepSlot sweep[5];
+        for (int i = 0; i < 5; i++)
+        {
+            sweep[i] = {simModules[i].address, simArrays[i], simModules[i].telemetrySize,
+                        SERVICE_NO_RESPONSE, INVALID_REQUEST_HANDLE, 0, 0};
+        }
+
+        tickStart = simNow;
+        awake = simAwakeMS;
+        wakeUps = simWakeUps;
+
+        CommunicationStartTick(COMMUNICATION_DEFAULT_BUDGET_MS);
+        RequestTelemetrySweep(sweep, 5);
+        for (int line = 1; line <= 4; line++)
+        {
+            payload[0] = 1;
+            payload[1] = SERVICE_RESPONSE_REQUEST;
+            payload[2] = line;
+            payload[3] = (line == 1);
+            replySize = sizeof(reply);
+            if (RequestReplyRetry(POWER_REQUEST, EPS, 4, payload, &replySize, reply, 500) != SERVICE_RESPONSE_REPLY)
+            {
+                continue;
+            }
+            if ((replySize != 4) || (reply[0] != 1))
+            {
+                wrongReplies++;
+            }
+            else if (reply[2] != line)
+            {
+                // A late reply to the previous line: PQ9 frames have no sequence number
+                staleReplies++;
+            }
+        }
+
+        CommunicationEndTick();
+        busMS = simNow - tickStart;
+        awake = simAwakeMS - awake;
+        wakeUps = simWakeUps - wakeUps;
+        engineDuty[tick] = (awake * 1000.0 + wakeUps * SIM_WAKEUP_US) / (SIM_TICK_PERIOD_MS * 1000.0);
+        pollingDuty[tick] = (double)busMS / SIM_TICK_PERIOD_MS;
+        totalWakeUps += wakeUps;
+
+        // The rest of the period: the CPU sleeps in the PeriodicTask, late replies may arrive
+        while (simNow < tickStart + SIM_TICK_PERIOD_MS)
+        {
+            SimAdvance1ms();
+        }
+        frames = simFrames;
+    }
+
+    printf("duty cycle of the bus traffic of a tick (%d ticks, %lu frames and %lu wake-ups per tick)\n",
+           SIM_TICKS, frames / SIM_TICKS, totalWakeUps / SIM_TICKS);
+    PrintDuty("polling engine", pollingDuty, SIM_TICKS);
+    PrintDuty("interrupt driven", engineDuty, SIM_TICKS);
+    printf("%d wrong power replies, %d late replies to the previous line\n", wrongReplies, staleReplies);
+    return (wrongReplies == 0) ? 0 : 1;
+}
@@ -0,0 +1,289 @@
+/*
+ *  CommunicationLatencySim.cpp
+ *
+ *  Host simulation of the latency between the telemetry of EPS which triggers
+ *  the safe mode and the power commands sent to EPS, under the contention of
+ *  the housekeeping sweep (Communication.cpp and PowerBusControl.cpp run as is).
+ *
+ *  Two strategies are compared on the same random bus:
+ *      after sweep     The decision is made once RequestTelemetrySweep() returned
+ *                      and the lines are set with PowerBusControlMask()
+ *      on EPS reply    The decision is made by the callback of the EPS slot and
+ *                      the lines are set with PowerBusControlAsync()
+ *
+ *  Model: OBC transmits a frame in 1ms, every module replies after a random
+ *  delay (a fast majority and a slow tail) or not at all. The time only moves
+ *  while OBC transmits or sleeps, like the Timer32 tick of Communication.cpp.
+ *
+ *  Build and run from the root of the repository:
+ *      g++ -std=c++14 -O2 -Itests/stubs -I. tests/CommunicationLatencySim.cpp Communication.cpp
+ *          TimeoutEstimator.cpp DirtyLines.cpp PowerBusControl.cpp EPSTelemetryContainer.cpp
+ *          -o latency_sim && ./latency_sim
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "Communication.h"
+#include "PowerBusControl.h"
+#include "EPSTelemetryContainer.h"
+#include "PQ9Bus.h"
+#include "ResetService.h"
+#include "Task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_TICKS               20000
+#define SIM_MAX_EVENTS          32
+#define SIM_MODULE_SIZE         64      // Telemetry of the modules other than EPS
+#define SIM_HOUSEKEEPING_LOSS   3       // % of housekeeping requests without reply
+#define SIM_POWER_LOSS          1       // % of power commands without reply
+#define SIM_SLOW_REPLY          10      // % of replies in the slow tail
+
+// Globals used by Communication.cpp (defined in main.cpp on the target)
+PQ9Bus pq9bus;
+ResetService reset;
+Task communicationTask;
+
+// Simulated time and interrupts
+unsigned long simNow;
+bool interruptsDisabled;
+bool timerRunning;
+void (*timerHandler)(void);
+
+// Frames sent by the modules, delivered to receivedCommand() when they are due
+typedef struct SimEvent
+{
+    unsigned long dueMS;
+    PQ9Frame frame;
+} SimEvent;
+
+SimEvent events[SIM_MAX_EVENTS];
+int eventCount;
+
+// Telemetry of the modules
+EPSTelemetryContainer epsModule;
+EPSTelemetryContainer EPSContainer;
+unsigned char moduleArrays[4][SIM_MODULE_SIZE];
+
+// Measurements of the current tick
+unsigned long epsReplyMS;
+unsigned long firstPowerMS;
+unsigned long lastPowerMS;
+bool epsReplied;
+bool decideOnReply;
+
+unsigned long simRandom()
+{
+    static unsigned long long state = 0x2545F4914F6CDD1DULL;
+
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unsigned long)(state >> 33);
+}
+
+unsigned long ReplyDelay()
+{
+    if ((simRandom() % 100) < SIM_SLOW_REPLY)
+    {
+        return 20 + simRandom() % 70;
+    }
+    return 3 + simRandom() % 12;
+}
+
+void Advance1ms()
+{
+    PQ9Frame due;
+
+    simNow++;
+    if (timerRunning && timerHandler)
+    {
+        timerHandler();
+    }
+
+    for (int i = 0; i < eventCount; )
+    {
+        if (events[i].dueMS > simNow)
+        {
+            i++;
+            continue;
+        }
+        due = events[i].frame;
+        events[i] = events[--eventCount];
+        receivedCommand(due);
+    }
+}
+
+void ScheduleReply(unsigned char source, unsigned char *payload, int size, unsigned long delayMS)
+{
+    if (eventCount >= SIM_MAX_EVENTS)
+    {
+        return;
+    }
+    SimEvent &event = events[eventCount++];
+    event.dueMS = simNow + delayMS;
+    event.frame.setSource(source);
+    event.frame.setDestination(OBC);
+    event.frame.setPayloadSize(size);
+    memcpy(event.frame.getPayload(), payload, size);
+}
+
+// The modules answer the housekeeping and power bus services
+void PQ9Bus::transmit(DataFrame &frame)
+{
+    unsigned char payload[2 + EPS_CONTAINER_SIZE];
+    unsigned char *sent = frame.getPayload();
+    unsigned char destination = frame.getDestination();
+
+    Advance1ms();
+
+    payload[0] = sent[0];
+    payload[1] = SERVICE_RESPONSE_REPLY;
+
+    if (sent[0] == 3)
+    {
+        if ((simRandom() % 100) < SIM_HOUSEKEEPING_LOSS)
+        {
+            return;
+        }
+        if (destination == EPS)
+        {
+            memcpy(payload + 2, epsModule.getArray(), EPS_CONTAINER_SIZE);
+            ScheduleReply(destination, payload, 2 + EPS_CONTAINER_SIZE, ReplyDelay());
+        }
+        else
+        {
+            memcpy(payload + 2, moduleArrays[0], SIM_MODULE_SIZE);
+            ScheduleReply(destination, payload, 2 + SIM_MODULE_SIZE, ReplyDelay());
+        }
+    }
+    else if ((destination == EPS) && (sent[0] == 1))
+    {
+        if (firstPowerMS == 0)
+        {
+            firstPowerMS = simNow;
+        }
+        lastPowerMS = simNow;
+
+        if ((simRandom() % 100) < SIM_POWER_LOSS)
+        {
+            return;
+        }
+        payload[2] = sent[2];
+        payload[3] = sent[3];
+        ScheduleReply(destination, payload, 4, ReplyDelay());
+    }
+}
+
+// driverlib stand-ins
+void MAP_Timer32_initModule(uint32_t, uint32_t, uint32_t, uint32_t) {}
+void MAP_Timer32_setCount(uint32_t, uint32_t) {}
+void MAP_Timer32_startTimer(uint32_t, bool) { timerRunning = true; }
+void MAP_Timer32_haltTimer(uint32_t) { timerRunning = false; }
+void MAP_Timer32_clearInterruptFlag(uint32_t) {}
+void MAP_Timer32_enableInterrupt(uint32_t) {}
+void MAP_Timer32_registerInterrupt(uint32_t, void (*handler)(void)) { timerHandler = handler; }
+bool MAP_Interrupt_disableMaster(void) { bool was = interruptsDisabled; interruptsDisabled = true; return was; }
+bool MAP_Interrupt_enableMaster(void) { interruptsDisabled = false; return true; }
+bool MAP_PCM_gotoLPM0(void) { Advance1ms(); return true; }
+
+// Slot of a module without container (only its array)
+TelemetrySweepSlot SimSlot(Address destination, unsigned char *array)
+{
+    TelemetrySweepSlot slot = {destination, array, SIM_MODULE_SIZE, SERVICE_NO_RESPONSE, INVALID_REQUEST_HANDLE, 0, 0};
+    return slot;
+}
+
+void EPSReceived(TelemetrySweepSlot &)
+{
+    epsReplied = true;
+    epsReplyMS = simNow;
+
+    if (decideOnReply)
+    {
+        PowerBusTelemetry(&EPSContainer, true);
+        PowerBusControlAsync(POWER_LINE_V1);
+    }
+}
+
+int CompareLatency(const void *a, const void *b)
+{
+    unsigned long x = *(const unsigned long *)a;
+    unsigned long y = *(const unsigned long *)b;
+    return (x > y) - (x < y);
+}
+
+void PrintLatency(const char *name, unsigned long *samples, int count)
+{
+    qsort(samples, count, sizeof(unsigned long), CompareLatency);
+    printf("    %-22s p50 %4lu  p90 %4lu  p99 %4lu  p99.9 %4lu  max %4lu ms\n", name,
+           samples[count / 2], samples[count * 90 / 100], samples[count * 99 / 100],
+           samples[count * 999 / 1000], samples[count - 1]);
+}
+
+void Simulate(bool onReply)
+{
+    static unsigned long firstLatency[SIM_TICKS];
+    static unsigned long lastLatency[SIM_TICKS];
+    int samples = 0;
+
+    decideOnReply = onReply;
+
+    for (int tick = 0; tick < SIM_TICKS; tick++)
+    {
+        TelemetrySweepSlot sweep[] = {SimSlot(ADB, moduleArrays[0]),
+                                      SimSlot(ADCS, moduleArrays[1]),
+                                      SimSlot(COMMS, moduleArrays[2]),
+                                      TelemetrySweepSlotOf(EPS, EPSContainer),
+                                      SimSlot(PROP, moduleArrays[3])};
+        sweep[3].received = EPSReceived;
+
+        // Every tick EPS reports all the lines on, so V2 ~ V4 have to be switched off
+        epsReplied = false;
+        firstPowerMS = 0;
+        lastPowerMS = 0;
+
+        CommunicationStartTick(COMMUNICATION_DEFAULT_BUDGET_MS);
+        RequestTelemetrySweep(sweep, 5);
+
+        if (!onReply)
+        {
+            PowerBusTelemetry(&EPSContainer, sweep[3].response == SERVICE_RESPONSE_REPLY);
+        }
+        PowerBusControlMask(POWER_LINE_V1);
+        CommunicationEndTick();
+
+        if (epsReplied && (firstPowerMS != 0))
+        {
+            firstLatency[samples] = firstPowerMS - epsReplyMS;
+            lastLatency[samples] = lastPowerMS - epsReplyMS;
+            samples++;
+        }
+
+        // The late replies arrive before the next tick
+        CommunicationSleep(200);
+    }
+
+    printf("%s (%d of %d ticks with EPS telemetry)\n", onReply ? "on EPS reply" : "after sweep",
+           samples, SIM_TICKS);
+    PrintLatency("first line command", firstLatency, samples);
+    PrintLatency("last line command", lastLatency, samples);
+}
+
+int main()
+{
+    epsModule.setB1Status(true);
+    epsModule.setB2Status(true);
+    epsModule.setB3Status(true);
+    epsModule.setB4Status(true);
+    epsModule.setBattVoltage(3000);
+
+    CommunicationInit();
+
+    Simulate(false);
+    Simulate(true);
+
+    printf("retries %lu, timeouts %lu, dropped %lu, commands sent %lu\n", CommunicationRetryCount(),
+           CommunicationTimeoutCount(), CommunicationDroppedCount(), PowerBusCommandsSent());
+    return 0;
+}
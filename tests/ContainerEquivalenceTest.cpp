@@ -0,0 +1,324 @@
+/*
+ *  ContainerEquivalenceTest.cpp
+ *
+ *  Host test of the container accessors generated from the field descriptors
+ *  (TelemetryField.h) against the hand-written accessors they replaced.
+ *
+ *  The same program is built twice, once with the containers of the tree and
+ *  once with the containers of the reference commit, and the outputs have to
+ *  be identical. Every setter/getter pair is called with 3 random values on a
+ *  random array, then the array is printed.
+ *
+ *  Known differences, checked only against the tree (FIXED):
+ *      getTorquerZCurrent() (ADB, ADCS) and getHeatersCurrent() (PROP) read
+ *      the bus current (16~17) in the reference, while their setters write
+ *      10~11. They now read back what the setter wrote.
+ *  The counters of the bus (OBC) were moved to the end of the array after the
+ *  reference, so only the fixed telemetry and the variables of OBC are filled
+ *  and printed.
+ *  The 4-byte fields are printed on 32 bits: on a 64-bit host the reference
+ *  getters leave the upper bytes of an unsigned long undefined.
+ *
+ *  Build, run and compare from the root of the repository:
+ *      sh tests/ContainerEquivalenceTest.sh
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "ADBTelemetryContainer.h"
+#include "ADCSTelemetryContainer.h"
+#include "COMMSTelemetryContainer.h"
+#include "EPSTelemetryContainer.h"
+#include "PROPTelemetryContainer.h"
+#include "OBCTelemetryContainer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK_VALUES        3
+#define OBC_FIXED_SIZE      24      // Telemetry of OBC before the counters (reference) or the variables
+
+#define CHECK(C, F)         Check(#C, #F, t, &C##TelemetryContainer::set##F, &C##TelemetryContainer::get##F)
+#define FIXED(C, F)         Fixed(#C, #F, t, &C##TelemetryContainer::set##F, &C##TelemetryContainer::get##F)
+
+int failures;
+
+template <class C, typename S, typename G>
+void Check(const char *container, const char *field, C &t, void (C::*set)(S), G (C::*get)())
+{
+    for (int i = 0; i < CHECK_VALUES; i++)
+    {
+        long value = rand() - RAND_MAX / 2;
+        (t.*set)((S)(G)value);
+        printf("%s %s %08lx\n", container, field, (unsigned long)(long)(t.*get)() & 0xFFFFFFFFUL);
+    }
+}
+
+template <class C, typename S, typename G>
+void Fixed(const char *container, const char *field, C &t, void (C::*set)(S), G (C::*get)())
+{
+    for (int i = 0; i < CHECK_VALUES; i++)
+    {
+        long value = rand() - RAND_MAX / 2;
+        (t.*set)((S)(G)value);
+#ifndef REFERENCE_ACCESSORS
+        if ((t.*get)() != (G)value)
+        {
+            fprintf(stderr, "%s %s does not read back %ld\n", container, field, (long)(G)value);
+            failures++;
+        }
+#endif
+    }
+}
+
+void Fill(unsigned char *array, int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        array[i] = (unsigned char)rand();
+    }
+}
+
+// The counters are cleared, the bytes between the fields keep the same value in both layouts
+void FillOBC(OBCTelemetryContainer &t)
+{
+    memset(t.getArray(), 0, t.size());
+    Fill(t.getArray(), OBC_FIXED_SIZE);
+    Fill(t.getVariablesArray(), t.VariablesSize());
+}
+
+void Dump(unsigned char *array, int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        printf("%02x", array[i]);
+    }
+    printf("\n");
+}
+
+void DumpOBC(OBCTelemetryContainer &t)
+{
+    Dump(t.getArray(), OBC_FIXED_SIZE);
+    Dump(t.getVariablesArray(), t.VariablesSize());
+}
+
+int main()
+{
+    srand(1);
+
+    {
+        ADBTelemetryContainer t;
+        Fill(t.getArray(), t.size());
+        CHECK(ADB, UpTime);
+        CHECK(ADB, TmpStatus);
+        CHECK(ADB, BusStatus);
+        CHECK(ADB, TorquerXStatus);
+        CHECK(ADB, TorquerYStatus);
+        CHECK(ADB, TorquerZStatus);
+        CHECK(ADB, Temperature);
+        FIXED(ADB, TorquerZCurrent);
+        CHECK(ADB, TorquerYCurrent);
+        CHECK(ADB, TorquerXCurrent);
+        CHECK(ADB, BusCurrent);
+        CHECK(ADB, TorquerZVoltage);
+        CHECK(ADB, TorquerYVoltage);
+        CHECK(ADB, TorquerXVoltage);
+        CHECK(ADB, BusVoltage);
+        Dump(t.getArray(), t.size());
+    }
+
+    {
+        ADCSTelemetryContainer t;
+        Fill(t.getArray(), t.size());
+        CHECK(ADCS, UpTime);
+        CHECK(ADCS, TmpStatus);
+        CHECK(ADCS, BusStatus);
+        CHECK(ADCS, TorquerXStatus);
+        CHECK(ADCS, TorquerYStatus);
+        CHECK(ADCS, TorquerZStatus);
+        CHECK(ADCS, Temperature);
+        FIXED(ADCS, TorquerZCurrent);
+        CHECK(ADCS, TorquerYCurrent);
+        CHECK(ADCS, TorquerXCurrent);
+        CHECK(ADCS, BusCurrent);
+        CHECK(ADCS, TorquerZVoltage);
+        CHECK(ADCS, TorquerYVoltage);
+        CHECK(ADCS, TorquerXVoltage);
+        CHECK(ADCS, BusVoltage);
+        Dump(t.getArray(), t.size());
+    }
+
+    {
+        COMMSTelemetryContainer t;
+        Fill(t.getArray(), t.size());
+        CHECK(COMMS, UpTime);
+        CHECK(COMMS, IntBStatus);
+        CHECK(COMMS, URBStatus);
+        CHECK(COMMS, SAYpStatus);
+        CHECK(COMMS, SAYmStatus);
+        CHECK(COMMS, SAXpStatus);
+        CHECK(COMMS, SAXmStatus);
+        CHECK(COMMS, BattStatus);
+        CHECK(COMMS, SAYpTmpStatus);
+        CHECK(COMMS, SAYmTmpStatus);
+        CHECK(COMMS, SAXpTmpStatus);
+        CHECK(COMMS, SAXmTmpStatus);
+        CHECK(COMMS, B1Status);
+        CHECK(COMMS, B2Status);
+        CHECK(COMMS, B3Status);
+        CHECK(COMMS, B4Status);
+        CHECK(COMMS, SAYpTemperature);
+        CHECK(COMMS, SAYmTemperature);
+        CHECK(COMMS, SAXpTemperature);
+        CHECK(COMMS, SAXmTemperature);
+        CHECK(COMMS, SAYpCurrent);
+        CHECK(COMMS, SAYmCurrent);
+        CHECK(COMMS, SAXpCurrent);
+        CHECK(COMMS, SAXmCurrent);
+        CHECK(COMMS, SAYpVoltage);
+        CHECK(COMMS, SAYmVoltage);
+        CHECK(COMMS, SAXpVoltage);
+        CHECK(COMMS, SAXmVoltage);
+        CHECK(COMMS, B1Current);
+        CHECK(COMMS, B2Current);
+        CHECK(COMMS, B3Current);
+        CHECK(COMMS, B4Current);
+        CHECK(COMMS, B1Voltage);
+        CHECK(COMMS, B2Voltage);
+        CHECK(COMMS, B3Voltage);
+        CHECK(COMMS, B4Voltage);
+        CHECK(COMMS, BattVoltage);
+        CHECK(COMMS, BattCapacity);
+        CHECK(COMMS, BattTemperature);
+        CHECK(COMMS, IntBCurrent);
+        CHECK(COMMS, IntBVoltage);
+        CHECK(COMMS, URBCurrent);
+        CHECK(COMMS, URBVoltage);
+        Dump(t.getArray(), t.size());
+    }
+
+    {
+        EPSTelemetryContainer t;
+        Fill(t.getArray(), t.size());
+        CHECK(EPS, UpTime);
+        CHECK(EPS, IntBStatus);
+        CHECK(EPS, URBStatus);
+        CHECK(EPS, SAYpStatus);
+        CHECK(EPS, SAYmStatus);
+        CHECK(EPS, SAXpStatus);
+        CHECK(EPS, SAXmStatus);
+        CHECK(EPS, BattStatus);
+        CHECK(EPS, BattINAStatus);
+        CHECK(EPS, SAYpTmpStatus);
+        CHECK(EPS, SAYmTmpStatus);
+        CHECK(EPS, SAXpTmpStatus);
+        CHECK(EPS, SAXmTmpStatus);
+        CHECK(EPS, B1Status);
+        CHECK(EPS, B2Status);
+        CHECK(EPS, B3Status);
+        CHECK(EPS, B4Status);
+        CHECK(EPS, SPYpStatus);
+        CHECK(EPS, SPYmStatus);
+        CHECK(EPS, SPXpStatus);
+        CHECK(EPS, SPXmStatus);
+        CHECK(EPS, SAYpTemperature);
+        CHECK(EPS, SAYmTemperature);
+        CHECK(EPS, SAXpTemperature);
+        CHECK(EPS, SAXmTemperature);
+        CHECK(EPS, SAYpCurrent);
+        CHECK(EPS, SAYmCurrent);
+        CHECK(EPS, SAXpCurrent);
+        CHECK(EPS, SAXmCurrent);
+        CHECK(EPS, SAYpVoltage);
+        CHECK(EPS, SAYmVoltage);
+        CHECK(EPS, SAXpVoltage);
+        CHECK(EPS, SAXmVoltage);
+        CHECK(EPS, SPYpCurrent);
+        CHECK(EPS, SPYmCurrent);
+        CHECK(EPS, SPXpCurrent);
+        CHECK(EPS, SPXmCurrent);
+        CHECK(EPS, SPYpVoltage);
+        CHECK(EPS, SPYmVoltage);
+        CHECK(EPS, SPXpVoltage);
+        CHECK(EPS, SPXmVoltage);
+        CHECK(EPS, B1Current);
+        CHECK(EPS, B2Current);
+        CHECK(EPS, B3Current);
+        CHECK(EPS, B4Current);
+        CHECK(EPS, B1Voltage);
+        CHECK(EPS, B2Voltage);
+        CHECK(EPS, B3Voltage);
+        CHECK(EPS, B4Voltage);
+        CHECK(EPS, BattVoltage);
+        CHECK(EPS, BattVoltage1);
+        CHECK(EPS, BattCurrent);
+        CHECK(EPS, BattCapacity);
+        CHECK(EPS, BattTemperature);
+        CHECK(EPS, MCUTemperature);
+        CHECK(EPS, IntBCurrent);
+        CHECK(EPS, IntBVoltage);
+        CHECK(EPS, URBCurrent);
+        CHECK(EPS, URBVoltage);
+        Dump(t.getArray(), t.size());
+    }
+
+    {
+        PROPTelemetryContainer t;
+        Fill(t.getArray(), t.size());
+        CHECK(PROP, UpTime);
+        CHECK(PROP, TmpStatus);
+        CHECK(PROP, BusStatus);
+        CHECK(PROP, ValveHoldStatus);
+        CHECK(PROP, ValveSpikeStatus);
+        CHECK(PROP, HeatersStatus);
+        CHECK(PROP, Temperature);
+        FIXED(PROP, HeatersCurrent);
+        CHECK(PROP, ValveSpikeCurrent);
+        CHECK(PROP, ValveHoldCurrent);
+        CHECK(PROP, BusCurrent);
+        CHECK(PROP, HeatersVoltage);
+        CHECK(PROP, ValveSpikeVoltage);
+        CHECK(PROP, ValveHoldVoltage);
+        CHECK(PROP, BusVoltage);
+        Dump(t.getArray(), t.size());
+    }
+
+    {
+        OBCTelemetryContainer t;
+        FillOBC(t);
+        CHECK(OBC, BootCount);
+        CHECK(OBC, UpTime);
+        CHECK(OBC, TotalUpTime);
+        CHECK(OBC, TMPStatus);
+        CHECK(OBC, BusStatus);
+        CHECK(OBC, BusVoltage);
+        CHECK(OBC, BusCurrent);
+        CHECK(OBC, Temperature);
+        CHECK(OBC, ADBResponse);
+        CHECK(OBC, ADCSResponse);
+        CHECK(OBC, COMMSResponse);
+        CHECK(OBC, EPSResponse);
+        CHECK(OBC, PROPResponse);
+        CHECK(OBC, RetryCount);
+        CHECK(OBC, TimeoutCount);
+        CHECK(OBC, Mode);
+        CHECK(OBC, EndOfActivation);
+        CHECK(OBC, DeployState);
+        CHECK(OBC, EndOfDeployState);
+        CHECK(OBC, DeployVoltage);
+        CHECK(OBC, ForcedDeployPeriod);
+        CHECK(OBC, DelayingDeployPeriod);
+        CHECK(OBC, SMVoltage);
+        CHECK(OBC, ADCSState);
+        CHECK(OBC, EndOfADCSState);
+        CHECK(OBC, RotateSpeedLimit);
+        CHECK(OBC, DetumblingPeriod);
+        CHECK(OBC, ADCSPowerState);
+        CHECK(OBC, EndOfADCSPowerState);
+        CHECK(OBC, ADCSPowerCyclePeriod);
+        DumpOBC(t);
+    }
+
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,49 @@
+#!/bin/sh
+#
+#  ContainerEquivalenceTest.sh
+#
+#  Builds tests/ContainerEquivalenceTest.cpp against the containers of the tree
+#  and against the hand-written containers of the reference commit (by default
+#  the parent of the commit which added TelemetryField.h), then compares the
+#  outputs. Run from the root of the repository:
+#      sh tests/ContainerEquivalenceTest.sh [reference commit]
+#
+#  Created on: 17 Oct 2026
+#      Author: agent
+#
+
+set -e
+
+REFERENCE=${1:-$(git log --diff-filter=A --format=%H -- TelemetryField.h | tail -n 1)^}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+CONTAINERS="ADB ADCS COMMS EPS PROP OBC"
+mkdir "$WORK/reference"
+for file in DirtyLines; do
+    git show "$REFERENCE:$file.h" > "$WORK/reference/$file.h"
+    git show "$REFERENCE:$file.cpp" > "$WORK/reference/$file.cpp"
+done
+for name in $CONTAINERS; do
+    git show "$REFERENCE:${name}TelemetryContainer.h" > "$WORK/reference/${name}TelemetryContainer.h"
+    # The store of an unsigned long before setting the uptime byte by byte writes 8 bytes on a 64-bit host
+    git show "$REFERENCE:${name}TelemetryContainer.cpp" | grep -v '^ *\*((unsigned long \*)&(telemetry\[0\])) = ulong;' \
+        > "$WORK/reference/${name}TelemetryContainer.cpp"
+done
+
+SOURCES=""
+REFERENCE_SOURCES="$WORK/reference/DirtyLines.cpp"
+for name in $CONTAINERS; do
+    SOURCES="$SOURCES ${name}TelemetryContainer.cpp"
+    REFERENCE_SOURCES="$REFERENCE_SOURCES $WORK/reference/${name}TelemetryContainer.cpp"
+done
+
+g++ -std=c++14 -O2 -Itests/stubs -I. tests/ContainerEquivalenceTest.cpp $SOURCES DirtyLines.cpp \
+    -o "$WORK/current"
+g++ -std=c++14 -O2 -DREFERENCE_ACCESSORS -Itests/stubs -I"$WORK/reference" tests/ContainerEquivalenceTest.cpp \
+    $REFERENCE_SOURCES -o "$WORK/reference/test"
+
+"$WORK/current" > "$WORK/current.txt"
+"$WORK/reference/test" > "$WORK/reference.txt"
+diff "$WORK/reference.txt" "$WORK/current.txt"
+echo "ContainerEquivalenceTest: $(wc -l < "$WORK/current.txt") lines identical to $REFERENCE"
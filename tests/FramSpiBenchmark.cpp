@@ -0,0 +1,402 @@
+/*
+ *  FramSpiBenchmark.cpp
+ *
+ *  Host measurement of the SPI traffic of OBCFramAccess.cpp (run as is) on a
+ *  mock of MB85RS which counts the transactions and bytes of the driver:
+ *      read        opcode, address, data
+ *      write       WREN (its own transaction), opcode, address, data
+ *      ping        RDID opcode and the 4 bytes of the device ID
+ *  The time is the bytes at the SPI clock of main.cpp (1MHz) plus the chip
+ *  select and the call of every transaction (SPI_TRANSACTION_US, an estimate).
+ *
+ *  Ping elision: the six writes of a StateMachine() tick, with the FRAM pinged
+ *  before every operation (OBCFramSetPingPeriod(0), like the baseline) and with
+ *  the cached health (OBCFRAM_DEFAULT_PING_PERIOD). The chip is then removed for
+ *  a few ticks: the test counts the writes reported as done while it's missing
+ *  and checks that every block reads back the last array once it's back.
+ *
+ *  Replay of the FRAM writes of StateMachine(): every tick the replies of the
+ *  five modules are copied with DirtyLinesCopy() (their uptime counts, a few
+ *  sensor bytes move) and the OBC container is updated through its setters like
+ *  acquireTelemetry() and the modes do, most of them with the same value. The
+ *  six blocks are written whole (OBCFramWrite()) or only their changed lines
+ *  (OBCFramWriteLines()), and the FRAM must hold the last arrays at the end.
+ *
+ *  Boot restore: time to the first valid telemetry after a reset, from the FRAM
+ *  written by the ticks before it. With OBCFramRestore() (one burst) and with
+ *  OBCFramRead() for every block, all six containers are valid once the FRAM is
+ *  read (the SPI time, the CRCs aren't counted). Before OBCFramRestore(), only
+ *  the OBC container was read: the five others were valid after the first
+ *  sweep of StateMachine(), FIRST_TICK_MS after the boot. The restored arrays
+ *  must be the last ones written.
+ *
+ *  Build and run from the root of the repository:
+ *      g++ -std=c++14 -O2 -Itests/stubs -I. tests/FramSpiBenchmark.cpp OBCFramAccess.cpp
+ *          OBCTelemetryContainer.cpp Checksum.cpp DirtyLines.cpp -o fram_spi_benchmark
+ *          && ./fram_spi_benchmark
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "OBCFramAccess.h"
+#include "OBCTelemetryContainer.h"
+#include "DirtyLines.h"
+#include "Checksum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPI_CLOCK_HZ            1000000 // spi.initMaster() in main.cpp
+#define SPI_ADDRESS_BYTES       3       // 2 on the MB85RS256, 3 on the larger parts
+#define SPI_TRANSACTION_US      5       // Chip select and call of a transaction
+#define BENCH_TICKS             6000
+#define MISSING_TICKS           20      // Ticks without the chip
+#define FIRST_TICK_MS           1000    // First StateMachine() tick (period of stateMachineTask)
+
+// Cached health of OBCFramAccess.cpp, false after a reset
+extern bool framAvailable;
+
+// Simulated FRAM
+unsigned char framMemory[OBCFRAM_LOG_ADDR];
+bool framPresent = true;
+unsigned long spiTransactions, spiBytes, spiPings;
+
+bool MB85RS::ping()
+{
+    spiTransactions++;
+    spiBytes += 1 + 4;
+    spiPings++;
+    return framPresent;
+}
+
+void MB85RS::read(unsigned int address, unsigned char *data, unsigned int size)
+{
+    spiTransactions++;
+    spiBytes += 1 + SPI_ADDRESS_BYTES + size;
+    if (framPresent)
+    {
+        memcpy(data, &framMemory[address], size);
+    }
+    else
+    {
+        memset(data, 0xFF, size);
+    }
+}
+
+void MB85RS::write(unsigned int address, unsigned char *data, unsigned int size)
+{
+    spiTransactions += 2;
+    spiBytes += 1 + 1 + SPI_ADDRESS_BYTES + size;
+    if (framPresent)
+    {
+        memcpy(&framMemory[address], data, size);
+    }
+}
+
+unsigned long MB85RS::getSize()
+{
+    return sizeof(framMemory);
+}
+
+// driverlib stand-ins (Checksum.cpp uses its table without ChecksumInit())
+void MAP_CRC32_setSeed(uint32_t, uint_fast8_t) {}
+void MAP_CRC32_set8BitData(uint8_t, uint_fast8_t) {}
+uint32_t MAP_CRC32_getResult(uint_fast8_t) { return 0; }
+uint32_t MAP_CRC32_getResultReversed(uint_fast8_t) { return 0; }
+
+MB85RS fram;
+unsigned char arrays[OBCFRAM_BLOCKS][OBCFRAM_MAX_ARRAY_SIZE];
+
+typedef struct SpiCount
+{
+    unsigned long transactions;
+    unsigned long bytes;
+    unsigned long pings;
+} SpiCount;
+
+SpiCount SpiNow()
+{
+    SpiCount now = {spiTransactions, spiBytes, spiPings};
+    return now;
+}
+
+double SpiMicroseconds(unsigned long transactions, unsigned long bytes)
+{
+    return bytes * 8.0 * 1000000 / SPI_CLOCK_HZ + transactions * (double)SPI_TRANSACTION_US;
+}
+
+/**
+ *
+ *  One tick of StateMachine(): the uptime of every array counts, a few bytes move,
+ *  and the six blocks are written. Returns the writes which didn't succeed.
+ *
+ */
+int WriteTick(int tick)
+{
+    int failed = 0;
+
+    for (unsigned int i = 0; i < OBCFRAM_BLOCKS; i++)
+    {
+        arrays[i][0] = tick >> 8;
+        arrays[i][1] = tick;
+        arrays[i][2 + rand() % (obcFramBlocks[i][1] - 2)]++;
+        if (OBCFramWrite(fram, obcFramBlocks[i][0], arrays[i], obcFramBlocks[i][1]) != FRAM_OPERATION_SUCCESS)
+        {
+            failed++;
+        }
+    }
+    return failed;
+}
+
+void PrintPerTick(const char *name, SpiCount start, int ticks)
+{
+    unsigned long transactions = spiTransactions - start.transactions;
+    unsigned long bytes = spiBytes - start.bytes;
+
+    printf("    %-22s %6.2f pings  %6.2f transactions  %7.1f bytes  %7.1f us per tick\n", name,
+           (double)(spiPings - start.pings) / ticks, (double)transactions / ticks, (double)bytes / ticks,
+           SpiMicroseconds(transactions, bytes) / ticks);
+}
+
+int PingElision()
+{
+    unsigned char check[OBCFRAM_MAX_ARRAY_SIZE];
+    SpiCount start, pingEvery, cached;
+    int tick = 0, failures = 0, reportedDone = 0;
+
+    printf("ping elision: six writes per tick, %d ticks\n", BENCH_TICKS);
+
+    OBCFramSetPingPeriod(0);
+    start = SpiNow();
+    for (int i = 0; i < BENCH_TICKS; i++)
+    {
+        failures += WriteTick(tick++);
+    }
+    PrintPerTick("ping every operation", start, BENCH_TICKS);
+    pingEvery = SpiNow();
+
+    OBCFramSetPingPeriod(OBCFRAM_DEFAULT_PING_PERIOD);
+    for (int i = 0; i < BENCH_TICKS; i++)
+    {
+        failures += WriteTick(tick++);
+    }
+    PrintPerTick("cached health", pingEvery, BENCH_TICKS);
+    cached = SpiNow();
+
+    // Both runs have the same writes: the difference is the pings
+    printf("    saved %.1f bytes and %.1f us per tick\n",
+           (double)(2 * pingEvery.bytes - start.bytes - cached.bytes) / BENCH_TICKS,
+           (SpiMicroseconds(pingEvery.transactions - start.transactions, pingEvery.bytes - start.bytes)
+            - SpiMicroseconds(cached.transactions - pingEvery.transactions, cached.bytes - pingEvery.bytes))
+               / BENCH_TICKS);
+
+    // The chip goes away, then comes back
+    framPresent = false;
+    for (int i = 0; i < MISSING_TICKS; i++)
+    {
+        reportedDone += (int)OBCFRAM_BLOCKS - WriteTick(tick++);
+    }
+    framPresent = true;
+    for (int i = 0; i < 2; i++)
+    {
+        failures += WriteTick(tick++);
+    }
+
+    for (unsigned int i = 0; i < OBCFRAM_BLOCKS; i++)
+    {
+        if ((OBCFramRead(fram, obcFramBlocks[i][0], check, obcFramBlocks[i][1]) != FRAM_OPERATION_SUCCESS)
+            || (memcmp(check, arrays[i], obcFramBlocks[i][1]) != 0))
+        {
+            failures++;
+        }
+    }
+    printf("    FRAM missing for %d ticks: %d of %d writes reported as done, %d failures after it's back\n",
+           MISSING_TICKS, reportedDone, MISSING_TICKS * (int)OBCFRAM_BLOCKS, failures);
+    return failures;
+}
+
+/**
+ *
+ *  One tick of StateMachine() with the OBC container: returns the bytes written
+ *  to the FRAM (without the SPI framing)
+ *
+ */
+unsigned long ReplayTick(OBCTelemetryContainer &obc, unsigned char modules[][OBCFRAM_MAX_ARRAY_SIZE],
+                         unsigned long *moduleLines, int tick, bool dirtyLines, unsigned long &obcWritten)
+{
+    static unsigned char reply[OBCFRAM_MAX_ARRAY_SIZE];
+    unsigned long before = OBCFramBytesWritten();
+    unsigned long obcBefore;
+
+    // The sweep: uptime of the module and a few sensor bytes
+    for (unsigned int i = 0; i < OBCFRAM_BLOCKS - 1; i++)
+    {
+        memcpy(reply, modules[i], obcFramBlocks[i][1]);
+        reply[2] = tick >> 8;
+        reply[3] = tick;
+        for (int j = 0; j < 3; j++)
+        {
+            reply[8 + rand() % (obcFramBlocks[i][1] - 8)] += (rand() % 3) - 1;
+        }
+        moduleLines[i] = DirtyLinesCopy(modules[i], reply, obcFramBlocks[i][1]);
+    }
+
+    // acquireTelemetry() and the modes: most values don't change
+    obc.setUpTime(obc.getUpTime() + 1);
+    obc.setTotalUpTime(obc.getTotalUpTime() + 1);
+    obc.setBusStatus(true);
+    obc.setTMPStatus(true);
+    obc.setBusVoltage(3700 + rand() % 3);
+    obc.setBusCurrent(120 + rand() % 3);
+    obc.setTemperature(200 + tick / 600);
+    obc.setADBResponse(2);
+    obc.setADCSResponse(2);
+    obc.setCOMMSResponse(2);
+    obc.setEPSResponse(2);
+    obc.setPROPResponse(2);
+    obc.setRetryCount(tick / 1000);
+    obc.setTimeoutCount(tick / 500);
+    obc.setMode(NOMINALMODE);
+    obc.setADCSPowerState(INITIALIZED);
+
+    for (unsigned int i = 0; i < OBCFRAM_BLOCKS - 1; i++)
+    {
+        if (dirtyLines)
+        {
+            OBCFramWriteLines(fram, obcFramBlocks[i][0], modules[i], obcFramBlocks[i][1], moduleLines[i]);
+        }
+        else
+        {
+            OBCFramWrite(fram, obcFramBlocks[i][0], modules[i], obcFramBlocks[i][1]);
+        }
+    }
+    obcBefore = OBCFramBytesWritten();
+    if (dirtyLines)
+    {
+        OBCFramWriteLines(fram, OBCFRAM_VARIABLES_ADDR, obc.getArray(), obc.size(), obc.getDirtyLines());
+    }
+    else
+    {
+        OBCFramWrite(fram, OBCFRAM_VARIABLES_ADDR, obc.getArray(), obc.size());
+    }
+    obc.clearDirtyLines();
+    obcWritten += OBCFramBytesWritten() - obcBefore;
+
+    return OBCFramBytesWritten() - before;
+}
+
+int ReplayWrites()
+{
+    static unsigned char modules[OBCFRAM_BLOCKS - 1][OBCFRAM_MAX_ARRAY_SIZE];
+    unsigned char check[OBCFRAM_MAX_ARRAY_SIZE];
+    unsigned long moduleLines[OBCFRAM_BLOCKS - 1];
+    unsigned long written, obcWritten;
+    OBCTelemetryContainer obc;
+    SpiCount start;
+    int failures = 0;
+
+    printf("replay of the FRAM writes of StateMachine(), %d ticks\n", BENCH_TICKS);
+
+    obc.FirstBootInit();
+    for (int run = 0; run < 2; run++)
+    {
+        start = SpiNow();
+        written = 0;
+        obcWritten = 0;
+        for (int tick = 0; tick < BENCH_TICKS; tick++)
+        {
+            written += ReplayTick(obc, modules, moduleLines, run * BENCH_TICKS + tick, run == 1, obcWritten);
+        }
+        PrintPerTick((run == 0) ? "whole blocks" : "changed lines", start, BENCH_TICKS);
+        printf("    %-22s %6.1f bytes written per tick, %5.1f of them to the OBC block\n", "",
+               (double)written / BENCH_TICKS, (double)obcWritten / BENCH_TICKS);
+
+        for (unsigned int i = 0; i < OBCFRAM_BLOCKS; i++)
+        {
+            if ((OBCFramRead(fram, obcFramBlocks[i][0], check, obcFramBlocks[i][1]) != FRAM_OPERATION_SUCCESS)
+                || (memcmp(check, (i < OBCFRAM_BLOCKS - 1) ? modules[i] : obc.getArray(), obcFramBlocks[i][1]) != 0))
+            {
+                failures++;
+            }
+        }
+    }
+    printf("    %d blocks don't hold the last array\n", failures);
+    return failures;
+}
+
+int BootRestore()
+{
+    static unsigned char restored[OBCFRAM_BLOCKS][OBCFRAM_MAX_ARRAY_SIZE];
+    unsigned char *restoreArrays[OBCFRAM_BLOCKS];
+    int results[OBCFRAM_BLOCKS];
+    SpiCount start;
+    double burstUs, readUs, obcUs;
+    int failures = 0, valid;
+
+    printf("boot restore: time to the first valid telemetry after a reset\n");
+
+    for (int tick = 0; tick < 10; tick++)
+    {
+        failures += WriteTick(tick);
+    }
+
+    // One burst
+    for (unsigned int i = 0; i < OBCFRAM_BLOCKS; i++)
+    {
+        restoreArrays[i] = restored[i];
+    }
+    memset(restored, 0, sizeof(restored));
+    framAvailable = false;
+    start = SpiNow();
+    valid = OBCFramRestore(fram, restoreArrays, results);
+    burstUs = SpiMicroseconds(spiTransactions - start.transactions, spiBytes - start.bytes);
+    for (unsigned int i = 0; i < OBCFRAM_BLOCKS; i++)
+    {
+        failures += (results[i] != FRAM_OPERATION_SUCCESS)
+                    || (memcmp(restored[i], arrays[i], obcFramBlocks[i][1]) != 0);
+    }
+    printf("    %-22s %d of %d containers valid after %7.1f us (%lu transactions, %lu bytes)\n", "OBCFramRestore()",
+           valid, (int)OBCFRAM_BLOCKS, burstUs, spiTransactions - start.transactions, spiBytes - start.bytes);
+
+    // A read for every block
+    memset(restored, 0, sizeof(restored));
+    framAvailable = false;
+    start = SpiNow();
+    valid = 0;
+    for (unsigned int i = 0; i < OBCFRAM_BLOCKS; i++)
+    {
+        if ((OBCFramRead(fram, obcFramBlocks[i][0], restored[i], obcFramBlocks[i][1]) == FRAM_OPERATION_SUCCESS)
+            && (memcmp(restored[i], arrays[i], obcFramBlocks[i][1]) == 0))
+        {
+            valid++;
+        }
+    }
+    readUs = SpiMicroseconds(spiTransactions - start.transactions, spiBytes - start.bytes);
+    failures += valid != (int)OBCFRAM_BLOCKS;
+    printf("    %-22s %d of %d containers valid after %7.1f us (%lu transactions, %lu bytes)\n", "OBCFramRead() x6",
+           valid, (int)OBCFRAM_BLOCKS, readUs, spiTransactions - start.transactions, spiBytes - start.bytes);
+
+    // Before OBCFramRestore(): the OBC block only, the modules at the first tick
+    framAvailable = false;
+    start = SpiNow();
+    failures += OBCFramRead(fram, OBCFRAM_VARIABLES_ADDR, restored[OBCFRAM_BLOCKS - 1],
+                            obcFramBlocks[OBCFRAM_BLOCKS - 1][1]) != FRAM_OPERATION_SUCCESS;
+    obcUs = SpiMicroseconds(spiTransactions - start.transactions, spiBytes - start.bytes);
+    printf("    %-22s 1 of %d containers valid after %7.1f us, the other %d after the first sweep (> %d ms)\n",
+           "OBC block only", (int)OBCFRAM_BLOCKS, obcUs, (int)OBCFRAM_BLOCKS - 1, FIRST_TICK_MS);
+    printf("    %d restored arrays aren't the last ones written\n", failures);
+    return failures;
+}
+
+int main()
+{
+    int failures = 0;
+
+    failures += PingElision();
+    failures += ReplayWrites();
+    failures += BootRestore();
+
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+/*
+ *  ReceiveRingStressTest.cpp
+ *
+ *  Host stress test of the receive ring of Communication.cpp (rxRing): a
+ *  producer thread calls receivedCommand() like the interrupt of the bus, the
+ *  main thread drains the ring with CommunicationPoll() like communicationTask.
+ *  On a multi-core host the two run at the same time, which is harsher
+ *  than the interrupt of the single-core target (see the comment of rxRing).
+ *
+ *  Every frame carries a sequence number, and its source, size and payload are
+ *  derived from it. The request handler gets the frames from the consumer and checks:
+ *      lost        a frame accepted by the ring never reached the consumer
+ *      duplicated  a frame reached the consumer twice (or out of order)
+ *      torn        the source, size or payload doesn't match the sequence number
+ *  A frame dropped because the ring was full is counted by
+ *  CommunicationRxOverflowCount(): the producer reads it after every call to
+ *  know which frames were accepted. The two threads yield at random (and the
+ *  producer after a full ring), so the ring is often full and often empty, and
+ *  the threads are also preempted at any instruction on a single-core host.
+ *  The test also fails if the ring was never full or never empty, or if it
+ *  accepted less than 10% of the frames (a ring stuck full).
+ *
+ *  Build and run from the root of the repository:
+ *      g++ -std=c++14 -O2 -pthread -Itests/stubs -I. tests/ReceiveRingStressTest.cpp Communication.cpp
+ *          TimeoutEstimator.cpp DirtyLines.cpp -o receive_ring_test && ./receive_ring_test
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "Communication.h"
+#include "PQ9Bus.h"
+#include "ResetService.h"
+#include "Task.h"
+#include "driverlib.h"
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+
+#define TEST_FRAMES         2000000
+#define TEST_SERVICE        99
+
+// Globals used by Communication.cpp (defined in main.cpp on the target)
+PQ9Bus pq9bus;
+ResetService reset;
+Task communicationTask;
+
+// Frames accepted by the ring, in order (written by the producer only)
+static unsigned long accepted[TEST_FRAMES];
+std::atomic<unsigned long> acceptedCount(0);
+std::atomic<bool> producerDone(false);
+
+unsigned long received, lost, duplicated, torn, emptyPolls;
+
+void PQ9Bus::transmit(DataFrame &) {}
+
+// driverlib stand-ins (only the consumer uses them)
+void MAP_Timer32_initModule(uint32_t, uint32_t, uint32_t, uint32_t) {}
+void MAP_Timer32_setCount(uint32_t, uint32_t) {}
+void MAP_Timer32_startTimer(uint32_t, bool) {}
+void MAP_Timer32_haltTimer(uint32_t) {}
+void MAP_Timer32_clearInterruptFlag(uint32_t) {}
+void MAP_Timer32_enableInterrupt(uint32_t) {}
+void MAP_Timer32_registerInterrupt(uint32_t, void (*)(void)) {}
+bool MAP_Interrupt_disableMaster(void) { return false; }
+bool MAP_Interrupt_enableMaster(void) { return true; }
+bool MAP_PCM_gotoLPM0(void) { return true; }
+
+unsigned long TestRandom(unsigned long long &state)
+{
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unsigned long)(state >> 33);
+}
+
+int FrameSize(unsigned long sequence)
+{
+    return 6 + sequence % 200;
+}
+
+unsigned char FrameByte(unsigned long sequence, int i)
+{
+    return (unsigned char)(sequence * 31 + i * 7);
+}
+
+// Checks the frames in the order the consumer gets them
+void CheckRequest(DataFrame &request)
+{
+    unsigned char *payload = request.getPayload();
+    unsigned long sequence;
+    bool ok;
+
+    sequence = payload[2] | (payload[3] << 8) | (payload[4] << 16) | ((unsigned long)payload[5] << 24);
+    ok = (payload[0] == TEST_SERVICE) && (request.getSource() == 2 + sequence % 5)
+         && (request.getPayloadSize() == FrameSize(sequence));
+    for (int i = 6; ok && (i < FrameSize(sequence)); i++)
+    {
+        ok = payload[i] == FrameByte(sequence, i);
+    }
+    if (!ok)
+    {
+        torn++;
+        return;
+    }
+
+    // The next accepted frame, unless frames were lost or it's a duplicate
+    while ((received < acceptedCount.load()) && (accepted[received] < sequence))
+    {
+        received++;
+        lost++;
+    }
+    if ((received < acceptedCount.load()) && (accepted[received] == sequence))
+    {
+        received++;
+    }
+    else
+    {
+        duplicated++;
+    }
+}
+
+void Producer()
+{
+    unsigned long long state = 1;
+    unsigned long overflows;
+    PQ9Frame frame;
+    int size;
+
+    for (unsigned long sequence = 0; sequence < TEST_FRAMES; sequence++)
+    {
+        size = FrameSize(sequence);
+        frame.setSource(2 + sequence % 5);
+        frame.setDestination(OBC);
+        frame.setPayloadSize(size);
+        frame.getPayload()[0] = TEST_SERVICE;
+        frame.getPayload()[1] = SERVICE_RESPONSE_REQUEST;
+        frame.getPayload()[2] = sequence;
+        frame.getPayload()[3] = sequence >> 8;
+        frame.getPayload()[4] = sequence >> 16;
+        frame.getPayload()[5] = sequence >> 24;
+        for (int i = 6; i < size; i++)
+        {
+            frame.getPayload()[i] = FrameByte(sequence, i);
+        }
+
+        // Record the frame before the consumer can see it, forget it if the ring was full
+        overflows = CommunicationRxOverflowCount();
+        accepted[acceptedCount.load()] = sequence;
+        acceptedCount.fetch_add(1);
+        receivedCommand(frame);
+        if (CommunicationRxOverflowCount() != overflows)
+        {
+            // Let the consumer run (the host may have a single core)
+            acceptedCount.fetch_sub(1);
+            std::this_thread::yield();
+        }
+
+        // Bursts and pauses of the producer
+        if ((TestRandom(state) % 16) == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producerDone = true;
+}
+
+int main()
+{
+    unsigned long long state = 2;
+    unsigned long before;
+    int failures;
+
+    CommunicationInit();
+    CommunicationSetRequestHandler(CheckRequest);
+
+    std::thread producer(Producer);
+
+    while (!producerDone.load())
+    {
+        before = received + duplicated + torn;
+        CommunicationPoll();
+        if (received + duplicated + torn == before)
+        {
+            emptyPolls++;
+        }
+
+        // Pauses of the consumer let the producer fill the ring
+        if ((TestRandom(state) % 4) == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    CommunicationPoll();
+
+    // The frames accepted after the last one received are lost
+    lost += acceptedCount.load() - received;
+
+    printf("%d frames sent, %lu accepted, %lu dropped (ring full), %lu empty polls\n", TEST_FRAMES,
+           acceptedCount.load(), CommunicationRxOverflowCount(), emptyPolls);
+    printf("%lu lost, %lu duplicated, %lu torn\n", lost, duplicated, torn);
+
+    failures = (lost != 0) || (duplicated != 0) || (torn != 0)
+               || (acceptedCount.load() + CommunicationRxOverflowCount() != TEST_FRAMES)
+               || (CommunicationRxOverflowCount() == 0) || (emptyPolls == 0)
+               || (acceptedCount.load() < TEST_FRAMES / 10);
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+    return failures;
+}
@@ -0,0 +1,469 @@
+/*
+ *  SDCardArchiveTest.cpp
+ *
+ *  Host test of the telemetry archive on the SD card (SDCardAccess.cpp and
+ *  OBCFramLog.cpp run as is). The SDCard of SDCard.h is replaced by the one of
+ *  the test, stored in a file: a sector is 512 bytes at sector * 512, the
+ *  sectors never written read as zero and an erase fills them with 0xFF. The time is simulated: it only advances in the operations
+ *  of the card (SIM_OP_MS), while the card programs or erases (isBusy()) and
+ *  during its initialization.
+ *
+ *  The ring is made small in the build options (4 segments of 8 sectors, 128
+ *  records), and the records are logged in a FRAM of LOG_RECORDS records, then
+ *  copied by SDCardAccess() every SIM_RUN_PERIOD ticks, with resets of the OBC
+ *  (OBCFramLogInit() and SDCardInit() again) every SIM_RESET_PERIOD ticks.
+ *
+ *  Checks:
+ *      init            a card slower than a run is initialized over several runs
+ *                      without starting it again; a card which never gets ready
+ *                      is started again every SDCARD_INIT_TIMEOUT_MS
+ *      time            no run lasts more than SDCARD_RUN_BUDGET_MS plus one
+ *                      operation of the card, and SDCardAccess() never starts an
+ *                      operation while the card is busy
+ *      erase           every sector is erased before it's written with new data
+ *                      (a sector written again after a reset gets the same data)
+ *      wrap-around     the ring wrapped several times, and the last rounds of
+ *                      records are in the archive with their data; the records
+ *                      left from the older rounds are in their own sector
+ *      index           SDCardSeek() finds the same segments after a reset, once
+ *                      the index is rebuilt from the card
+ *      resets          the sectors written again after the resets are at most
+ *                      the FRAM log (LOG_RECORDS) per reset
+ *
+ *  Benchmark of the scenario: write amplification (sectors written per sector
+ *  of new records, and bytes written to the card per byte of record), erased
+ *  sectors per sector written, and records per second, in the simulated time of
+ *  the card and in the time of the host with the file.
+ *
+ *  Build and run from the root of the repository:
+ *      g++ -std=c++14 -O2 -Itests/stubs -I. -DSDCARD_CS_PORT=0 -DSDCARD_CS_PIN=0
+ *          -DSDCARD_LOG_FIRST_SECTOR=16 -DSDCARD_SEGMENT_SECTORS=8 -DSDCARD_LOG_SEGMENTS=4
+ *          tests/SDCardArchiveTest.cpp SDCardAccess.cpp OBCFramLog.cpp Checksum.cpp
+ *          -o sd_archive_test && ./sd_archive_test
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "SDCardAccess.h"
+#include "OBCFramAccess.h"
+#include "Communication.h"
+#include "Checksum.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef SDCARD_ENABLED
+#error "Build with -DSDCARD_CS_PORT=0 -DSDCARD_CS_PIN=0 (see the build command above)"
+#endif
+
+static_assert(SDCARD_LOG_SEGMENTS * SDCARD_SEGMENT_SECTORS <= 64, "Build with the small ring of the build command");
+
+#define SIM_OP_MS           1       // Command and transfer of a sector
+#define SIM_PROGRAM_MS      3       // The card is busy after a sector write
+#define SIM_ERASE_MS        150     // The card is busy after the erase of a segment
+#define SIM_INIT_MS         100     // Initialization of the card of the scenario
+#define SIM_SLOW_INIT_MS    500     // Initialization of the slow card
+#define SIM_DEAD_RUNS       20      // Runs with a card which never gets ready
+#define SIM_TICKS           4000
+#define SIM_RECORDS_PER_TICK 3
+#define SIM_RUN_PERIOD      10      // Ticks between two runs of SDCardAccess() (like SDCardTask)
+#define SIM_RESET_PERIOD    700
+#define LOG_RECORDS         64      // Records of the simulated FRAM (OBCFRAM_LOG_MIN_RECORDS)
+#define RING_END            (SDCARD_LOG_FIRST_SECTOR + SDCARD_LOG_SEGMENTS * SDCARD_SEGMENT_SECTORS)
+
+// Simulated FRAM
+MB85RS fram;
+unsigned char framMemory[OBCFRAM_LOG_ADDR + LOG_RECORDS * OBCFRAM_LOG_RECORD_SIZE];
+
+bool MB85RS::ping()
+{
+    return true;
+}
+
+void MB85RS::read(unsigned int address, unsigned char *data, unsigned int size)
+{
+    memcpy(data, &framMemory[address], size);
+}
+
+void MB85RS::write(unsigned int address, unsigned char *data, unsigned int size)
+{
+    memcpy(&framMemory[address], data, size);
+}
+
+unsigned long MB85RS::getSize()
+{
+    return sizeof(framMemory);
+}
+
+// Simulated time, the clock of Communication.cpp (see CommunicationHoldClock())
+unsigned long simMS;
+bool clockHeld;
+int unheldReads;
+
+void CommunicationHoldClock()
+{
+    clockHeld = true;
+}
+
+void CommunicationReleaseClock()
+{
+    clockHeld = false;
+}
+
+unsigned long CommunicationTimeMS()
+{
+    unheldReads += !clockHeld;
+    return simMS;
+}
+
+// Simulated card, stored in a file (SDCard.h with the methods below instead of SDCard.cpp)
+DSPI spi;
+SDCard sdCard(spi, SDCARD_CS_PORT, SDCARD_CS_PIN);
+FILE *cardFile;
+unsigned long cardInitMS;           // Time the card needs to initialize
+unsigned long cardInitElapsed;      // Time spent in initStep() since start()
+bool cardStarted, cardReady, cardNeverReady;
+unsigned long cardBusyUntil;
+unsigned long cardStarts, cardWrites, cardReads, cardErases;
+int busyViolations, notReadyViolations, overwriteViolations;
+bool erased[RING_END];
+
+// SDCard.cpp waits for a busy card in every operation: SDCardAccess() must not
+// let it wait (its runs check isBusy() first), SDCardRead() can
+void CardOperation()
+{
+    if (simMS < cardBusyUntil)
+    {
+        busyViolations += clockHeld;
+        simMS = cardBusyUntil;
+    }
+    if (!cardReady)
+    {
+        notReadyViolations++;
+    }
+    simMS += SIM_OP_MS;
+}
+
+void CardRead(unsigned long sector, unsigned char *data)
+{
+    size_t size;
+
+    fseek(cardFile, sector * SDCARD_SECTOR_SIZE, SEEK_SET);
+    size = fread(data, 1, SDCARD_SECTOR_SIZE, cardFile);
+    memset(&data[size], 0, SDCARD_SECTOR_SIZE - size);
+}
+
+void CardWrite(unsigned long sector, unsigned char *data)
+{
+    fseek(cardFile, sector * SDCARD_SECTOR_SIZE, SEEK_SET);
+    fwrite(data, 1, SDCARD_SECTOR_SIZE, cardFile);
+}
+
+SDCard::SDCard(DSPI &spi, unsigned long port, unsigned long pin) :
+        line(spi), csPort(port), csPin(pin), blockAddressing(true), version2(true)
+{
+}
+
+bool SDCard::start()
+{
+    simMS += SIM_OP_MS;
+    cardStarts++;
+    cardStarted = true;
+    cardReady = false;
+    cardInitElapsed = 0;
+    return true;
+}
+
+int SDCard::initStep()
+{
+    simMS += SIM_OP_MS;
+    if (!cardStarted)
+    {
+        return SDCARD_ERROR;
+    }
+    cardInitElapsed += SIM_OP_MS;
+    cardReady = !cardNeverReady && (cardInitElapsed >= cardInitMS);
+    return cardReady ? SDCARD_READY : SDCARD_INITIALIZING;
+}
+
+bool SDCard::writeSector(unsigned long sector, unsigned char *data)
+{
+    unsigned char previous[SDCARD_SECTOR_SIZE];
+
+    CardOperation();
+    if (sector < RING_END && !erased[sector])
+    {
+        // Written before: only the same data can be written again without an erase
+        CardRead(sector, previous);
+        overwriteViolations += memcmp(previous, data, SDCARD_SECTOR_SIZE) != 0;
+    }
+    if (sector < RING_END)
+    {
+        erased[sector] = false;
+    }
+    CardWrite(sector, data);
+    cardWrites++;
+    cardBusyUntil = simMS + SIM_PROGRAM_MS;
+    return true;
+}
+
+bool SDCard::readSector(unsigned long sector, unsigned char *data)
+{
+    CardOperation();
+    CardRead(sector, data);
+    cardReads++;
+    return true;
+}
+
+bool SDCard::erase(unsigned long first, unsigned long last)
+{
+    unsigned char ones[SDCARD_SECTOR_SIZE];
+
+    CardOperation();
+    memset(ones, 0xFF, sizeof(ones));
+    for (unsigned long sector = first; (sector <= last) && (sector < RING_END); sector++)
+    {
+        CardWrite(sector, ones);
+        erased[sector] = true;
+    }
+    cardErases++;
+    cardBusyUntil = simMS + SIM_ERASE_MS;
+    return true;
+}
+
+bool SDCard::isBusy()
+{
+    if (simMS < cardBusyUntil)
+    {
+        simMS++;
+        return true;
+    }
+    return false;
+}
+
+// driverlib stand-ins (Checksum.cpp uses its table without ChecksumInit())
+void MAP_CRC32_setSeed(uint32_t, uint_fast8_t) {}
+void MAP_CRC32_set8BitData(uint8_t, uint_fast8_t) {}
+uint32_t MAP_CRC32_getResult(uint_fast8_t) { return 0; }
+uint32_t MAP_CRC32_getResultReversed(uint_fast8_t) { return 0; }
+
+// The records of the simulation are derived from their sequence number
+unsigned long RecordTime(unsigned long sequence)
+{
+    return 2 * sequence;
+}
+
+int RecordSize(unsigned long sequence)
+{
+    return 10 + sequence % 60;
+}
+
+unsigned char RecordByte(unsigned long sequence, int i)
+{
+    return (unsigned char)(sequence * 7 + i);
+}
+
+void AppendRecord()
+{
+    unsigned char payload[OBCFRAM_LOG_MAX_PAYLOAD];
+    unsigned long sequence = OBCFramLogNextSequence();
+
+    for (int i = 0; i < RecordSize(sequence); i++)
+    {
+        payload[i] = RecordByte(sequence, i);
+    }
+    OBCFramLogAppend(fram, RecordTime(sequence), 1 + sequence % 6, payload, RecordSize(sequence));
+}
+
+bool RecordMatches(unsigned char *record, unsigned long sequence)
+{
+    if (!OBCFramLogCheckRecord(record) || (GetLong(&record[0]) != sequence)
+        || (GetLong(&record[4]) != RecordTime(sequence)) || (record[8] != 1 + sequence % 6)
+        || (record[9] != RecordSize(sequence)))
+    {
+        return false;
+    }
+    for (int i = 0; i < RecordSize(sequence); i++)
+    {
+        if (record[OBCFRAM_LOG_HEADER_SIZE + i] != RecordByte(sequence, i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// One run of SDCardTask, timed
+unsigned long maxRunMS, totalRunMS;
+double hostSeconds;
+int slowRuns;
+
+void Run()
+{
+    unsigned long start = simMS;
+    struct timespec begin, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    SDCardAccess();
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    hostSeconds += (end.tv_sec - begin.tv_sec) + (end.tv_nsec - begin.tv_nsec) * 1e-9;
+    totalRunMS += simMS - start;
+    if (simMS - start > maxRunMS)
+    {
+        maxRunMS = simMS - start;
+    }
+    slowRuns += simMS - start > SDCARD_RUN_BUDGET_MS + SIM_OP_MS;
+}
+
+int main()
+{
+    unsigned char sector[SDCARD_SECTOR_SIZE];
+    unsigned long seeks[64];
+    unsigned long first, end, sequence, writes, recordBytes = 0;
+    unsigned long sectorsWritten, extraSectors, erasedSectors;
+    int runs, failures = 0;
+    int missing = 0, misplaced = 0, seekChanges = 0;
+
+    cardFile = tmpfile();
+    if (cardFile == NULL)
+    {
+        printf("no temporary file\n");
+        return 1;
+    }
+    OBCFramLogInit(fram);
+
+    // A card slower than a run: it's initialized over several runs, started once
+    cardInitMS = SIM_SLOW_INIT_MS;
+    SDCardInit();
+    for (runs = 0; !cardReady && (runs < 20); runs++)
+    {
+        Run();
+    }
+    printf("slow card (%d ms): ready after %d runs, %lu start\n", SIM_SLOW_INIT_MS, runs, cardStarts);
+    failures += !cardReady || (runs < 3) || (cardStarts != 1);
+
+    // A card which never gets ready is started again after SDCARD_INIT_TIMEOUT_MS
+    cardNeverReady = true;
+    cardStarts = 0;
+    cardStarted = false;
+    cardReady = false;
+    SDCardInit();
+    for (runs = 0; runs < SIM_DEAD_RUNS; runs++)
+    {
+        Run();
+    }
+    printf("dead card: %lu starts in %d runs of %d ms\n", cardStarts, SIM_DEAD_RUNS, SDCARD_RUN_BUDGET_MS);
+    failures += (cardStarts < SIM_DEAD_RUNS * SDCARD_RUN_BUDGET_MS / SDCARD_INIT_TIMEOUT_MS - 1)
+                || (cardStarts > SIM_DEAD_RUNS * SDCARD_RUN_BUDGET_MS / SDCARD_INIT_TIMEOUT_MS + 1)
+                || (cardWrites != 0);
+
+    // The scenario: records logged every tick, copied every SIM_RUN_PERIOD ticks, resets
+    cardNeverReady = false;
+    cardInitMS = SIM_INIT_MS;
+    totalRunMS = 0;
+    hostSeconds = 0;
+    for (int tick = 1; tick <= SIM_TICKS; tick++)
+    {
+        for (int i = 0; i < SIM_RECORDS_PER_TICK; i++)
+        {
+            AppendRecord();
+        }
+        if (tick % SIM_RESET_PERIOD == 0)
+        {
+            OBCFramLogInit(fram);
+            SDCardInit();
+        }
+        if (tick % SIM_RUN_PERIOD == 0)
+        {
+            Run();
+        }
+    }
+
+    // Copy the last full sectors
+    do
+    {
+        writes = cardWrites;
+        Run();
+    } while (cardWrites != writes);
+
+    // Write amplification: every sector of records from 0 to end is new once
+    end = OBCFramLogNextSequence() - OBCFramLogNextSequence() % SDCARD_RECORDS_PER_SECTOR;
+    for (sequence = 0; sequence < end; sequence++)
+    {
+        recordBytes += OBCFRAM_LOG_HEADER_SIZE + RecordSize(sequence) + 4;
+    }
+    sectorsWritten = SDCardSectorsWritten();
+    extraSectors = sectorsWritten - end / SDCARD_RECORDS_PER_SECTOR;
+    erasedSectors = SDCardSegmentsErased() * SDCARD_SEGMENT_SECTORS;
+    printf("write amplification (%d resets): %.3f sectors written per new sector (%lu written again), "
+           "%.2f bytes written per byte of record, %.3f sectors erased per sector written\n",
+           SIM_TICKS / SIM_RESET_PERIOD, (double)sectorsWritten / (end / SDCARD_RECORDS_PER_SECTOR), extraSectors,
+           (double)sectorsWritten * SDCARD_SECTOR_SIZE / recordBytes, (double)erasedSectors / sectorsWritten);
+    printf("records per second: %.0f in the time of the card (%lu ms of runs), %.0f on the host with a file\n",
+           end / (totalRunMS / 1000.0), totalRunMS, end / hostSeconds);
+    failures += extraSectors > (SIM_TICKS / SIM_RESET_PERIOD) * (LOG_RECORDS / SDCARD_RECORDS_PER_SECTOR);
+
+    // The last rounds are in the archive: the current segment and the ones before it
+    first = (end / SDCARD_RECORDS_PER_SEGMENT - (SDCARD_LOG_SEGMENTS - 1)) * SDCARD_RECORDS_PER_SEGMENT;
+    for (sequence = first; sequence < end; sequence++)
+    {
+        if ((sequence % SDCARD_RECORDS_PER_SECTOR == 0) && !SDCardRead(sequence, sector))
+        {
+            memset(sector, 0, sizeof(sector));
+        }
+        missing += !RecordMatches(&sector[(sequence % SDCARD_RECORDS_PER_SECTOR) * OBCFRAM_LOG_RECORD_SIZE],
+                                  sequence);
+    }
+
+    // Every valid record of the ring (also the older rounds) is in its own sector
+    for (unsigned long s = SDCARD_LOG_FIRST_SECTOR; s < RING_END; s++)
+    {
+        CardRead(s, sector);
+        for (int i = 0; i < SDCARD_RECORDS_PER_SECTOR; i++)
+        {
+            unsigned char *record = &sector[i * OBCFRAM_LOG_RECORD_SIZE];
+
+            sequence = GetLong(record);
+            if (OBCFramLogCheckRecord(record)
+                && (!RecordMatches(record, sequence)
+                    || (SDCARD_LOG_FIRST_SECTOR + (sequence / SDCARD_RECORDS_PER_SECTOR)
+                        % (SDCARD_LOG_SEGMENTS * SDCARD_SEGMENT_SECTORS) != s)))
+            {
+                misplaced++;
+            }
+        }
+    }
+
+    // The index rebuilt after a reset finds the same segments
+    for (int i = 0; i < 64; i++)
+    {
+        seeks[i] = SDCardSeek(RecordTime(first) + i * (end - first) * 2 / 64);
+    }
+    SDCardInit();
+    Run();
+    for (int i = 0; i < 64; i++)
+    {
+        seekChanges += SDCardSeek(RecordTime(first) + i * (end - first) * 2 / 64) != seeks[i];
+    }
+    seekChanges += (SDCardSeek(RecordTime(end - 1)) != (end - 1) - (end - 1) % SDCARD_RECORDS_PER_SEGMENT);
+
+    printf("%d records logged, %lu sectors written, %lu segments erased (ring of %d sectors)\n",
+           SIM_TICKS * SIM_RECORDS_PER_TICK, SDCardSectorsWritten(), SDCardSegmentsErased(),
+           SDCARD_LOG_SEGMENTS * SDCARD_SEGMENT_SECTORS);
+    printf("longest run %lu ms (budget %d ms), %d runs over budget, %d operations on a busy card, "
+           "%d on a card not ready, %d clock reads not held\n",
+           maxRunMS, SDCARD_RUN_BUDGET_MS, slowRuns, busyViolations, notReadyViolations, unheldReads);
+    printf("%d sectors written without an erase, %d of %lu last records missing, %d misplaced, "
+           "%d seeks changed by the reset\n",
+           overwriteViolations, missing, end - first, misplaced, seekChanges);
+
+    failures += (slowRuns != 0) || (busyViolations != 0) || (notReadyViolations != 0) || (unheldReads != 0)
+                || (overwriteViolations != 0) || (missing != 0) || (misplaced != 0) || (seekChanges != 0)
+                || (SDCardSectorsWritten() < 3 * SDCARD_LOG_SEGMENTS * SDCARD_SEGMENT_SECTORS)
+                || (SDCardSegmentsErased() != cardErases);
+    fclose(cardFile);
+
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+/*
+ *  SimulatedBus.cpp
+ *
+ *  Please read SimulatedBus.h
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "SimulatedBus.h"
+#include "PQ9Bus.h"
+#include "ResetService.h"
+#include "Task.h"
+#include "driverlib.h"
+#include <string.h>
+
+// Globals used by Communication.cpp (defined in main.cpp on the target)
+PQ9Bus pq9bus;
+ResetService reset;
+Task communicationTask;
+
+unsigned long simNow;
+unsigned long simAwakeMS;
+unsigned long simSleepMS;
+unsigned long simWakeUps;
+unsigned long simFrames;
+
+bool interruptsDisabled;
+bool timerRunning;
+void (*timerHandler)(void);
+
+SimModule modules[SIM_MAX_MODULES];
+int moduleCount;
+
+// Frames sent by the modules, delivered to receivedCommand() when they are due
+typedef struct SimEvent
+{
+    unsigned long dueMS;
+    PQ9Frame frame;
+} SimEvent;
+
+SimEvent events[SIM_MAX_EVENTS];
+int eventCount;
+
+unsigned long SimRandom()
+{
+    static unsigned long long state = 0x2545F4914F6CDD1DULL;
+
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unsigned long)(state >> 33);
+}
+
+void SimReset()
+{
+    moduleCount = 0;
+    eventCount = 0;
+    simAwakeMS = 0;
+    simSleepMS = 0;
+    simWakeUps = 0;
+    simFrames = 0;
+}
+
+void SimAddModule(const SimModule &module)
+{
+    for (int i = 0; i < moduleCount; i++)
+    {
+        if (modules[i].address == module.address)
+        {
+            modules[i] = module;
+            return;
+        }
+    }
+    if (moduleCount < SIM_MAX_MODULES)
+    {
+        modules[moduleCount++] = module;
+    }
+}
+
+void SimAdvance1ms()
+{
+    PQ9Frame due;
+
+    simNow++;
+    if (timerRunning && timerHandler)
+    {
+        timerHandler();
+    }
+
+    for (int i = 0; i < eventCount; )
+    {
+        if (events[i].dueMS > simNow)
+        {
+            i++;
+            continue;
+        }
+        due = events[i].frame;
+        events[i] = events[--eventCount];
+        receivedCommand(due);
+    }
+}
+
+unsigned long ReplyDelay(const SimModule &module)
+{
+    if ((int)(SimRandom() % 100) < module.slowPercent)
+    {
+        return module.slowMinMS + SimRandom() % (module.slowMaxMS - module.slowMinMS + 1);
+    }
+    return module.fastMinMS + SimRandom() % (module.fastMaxMS - module.fastMinMS + 1);
+}
+
+void PQ9Bus::transmit(DataFrame &frame)
+{
+    SimModule *module = 0;
+    SimEvent *event;
+    unsigned char *sent = frame.getPayload();
+    int size;
+
+    simFrames++;
+    for (int i = 0; i < SIM_FRAME_MS; i++)
+    {
+        simAwakeMS++;
+        SimAdvance1ms();
+    }
+
+    for (int i = 0; i < moduleCount; i++)
+    {
+        if (modules[i].address == frame.getDestination())
+        {
+            module = &modules[i];
+        }
+    }
+
+    // Only the requests get a reply
+    if ((module == 0) || (frame.getPayloadSize() < 2) || (sent[1] != SERVICE_RESPONSE_REQUEST)
+        || ((int)(SimRandom() % 100) < module->lossPercent) || (eventCount >= SIM_MAX_EVENTS))
+    {
+        return;
+    }
+
+    event = &events[eventCount++];
+    event->dueMS = simNow + ReplyDelay(*module);
+    event->frame.setSource(module->address);
+    event->frame.setDestination(OBC);
+    event->frame.getPayload()[0] = sent[0];
+    event->frame.getPayload()[1] = SERVICE_RESPONSE_REPLY;
+
+    if (sent[0] == 3)
+    {
+        // Housekeeping: the telemetry changes a little every time
+        size = module->telemetrySize;
+        for (int i = 0; i < size; i++)
+        {
+            event->frame.getPayload()[2 + i] = (unsigned char)(simNow >> (8 * (i & 3)));
+        }
+    }
+    else
+    {
+        size = frame.getPayloadSize() - 2;
+        memcpy(event->frame.getPayload() + 2, sent + 2, size);
+    }
+    event->frame.setPayloadSize(2 + size);
+}
+
+// driverlib stand-ins
+void MAP_Timer32_initModule(uint32_t, uint32_t, uint32_t, uint32_t) {}
+void MAP_Timer32_setCount(uint32_t, uint32_t) {}
+void MAP_Timer32_startTimer(uint32_t, bool) { timerRunning = true; }
+void MAP_Timer32_haltTimer(uint32_t) { timerRunning = false; }
+void MAP_Timer32_clearInterruptFlag(uint32_t) {}
+void MAP_Timer32_enableInterrupt(uint32_t) {}
+void MAP_Timer32_registerInterrupt(uint32_t, void (*handler)(void)) { timerHandler = handler; }
+bool MAP_Interrupt_disableMaster(void) { bool was = interruptsDisabled; interruptsDisabled = true; return was; }
+bool MAP_Interrupt_enableMaster(void) { interruptsDisabled = false; return true; }
+
+bool MAP_PCM_gotoLPM0(void)
+{
+    // The next interrupt is the tick (1ms) when it runs, otherwise a received frame
+    simSleepMS++;
+    SimAdvance1ms();
+    simWakeUps++;
+    return true;
+}
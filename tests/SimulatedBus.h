@@ -0,0 +1,77 @@
+/*
+ *  SimulatedBus.h
+ *
+ *  Simulated PQ9 bus for the host benchmarks of Communication.cpp: it defines
+ *  pq9bus, the Timer32, interrupt and low-power stand-ins of driverlib and the
+ *  modules answering the requests of OBC.
+ *
+ *  The time moves in steps of 1ms, only while OBC transmits (SIM_FRAME_MS per
+ *  frame, the CPU is awake) or sleeps in LPM0, like the Timer32 tick of
+ *  Communication.cpp. Every step runs the tick interrupt when it's started and
+ *  delivers the replies which are due to receivedCommand().
+ *
+ *  A module replies to every service: the housekeeping reply carries
+ *  telemetrySize bytes, the others echo the payload of the request. The delay
+ *  of a reply is drawn from a fast range, or from a slow tail in slowPercent
+ *  of the replies, and lossPercent of the requests get no reply.
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef SIMULATEDBUS_H_
+#define SIMULATEDBUS_H_
+
+#include "Communication.h"
+
+#define SIM_MAX_MODULES     8
+#define SIM_MAX_EVENTS      32
+#define SIM_FRAME_MS        1       // Time to transmit a frame
+
+typedef struct SimModule
+{
+    Address address;
+    int telemetrySize;
+    unsigned long fastMinMS;        // Usual delay of a reply
+    unsigned long fastMaxMS;
+    int slowPercent;                // % of replies in the slow tail
+    unsigned long slowMinMS;
+    unsigned long slowMaxMS;
+    int lossPercent;                // % of requests without reply
+} SimModule;
+
+extern unsigned long simNow;        // Simulated time in ms
+extern unsigned long simAwakeMS;    // Time spent transmitting
+extern unsigned long simSleepMS;    // Time spent in LPM0
+extern unsigned long simWakeUps;    // Returns from LPM0 (an interrupt woke the CPU up)
+extern unsigned long simFrames;     // Frames transmitted by OBC
+
+/**
+ *
+ *  Pseudo-random numbers (the same sequence on every host)
+ *
+ */
+unsigned long SimRandom();
+
+/**
+ *
+ *  Remove the modules and the replies in flight, clear the counters
+ *
+ */
+void SimReset();
+
+/**
+ *
+ *  Add a module to the bus (replaces the module with the same address)
+ *
+ */
+void SimAddModule(const SimModule &module);
+
+/**
+ *
+ *  Let the time move by 1ms (the replies which are due are received)
+ *
+ */
+void SimAdvance1ms();
+
+#endif /* SIMULATEDBUS_H_ */
@@ -0,0 +1,151 @@
+/*
+ *  SweepBenchmark.cpp
+ *
+ *  Host benchmark of the housekeeping sweep of the five modules
+ *  (Communication.cpp runs as is on the simulated bus of SimulatedBus.h):
+ *      serial          RequestTelemetry() for every module, one after another,
+ *                      like StateMachine() did before RequestTelemetrySweep()
+ *      pipelined       RequestTelemetrySweep() of the five modules
+ *  The two alternate tick by tick, so they share the timeout estimation.
+ *
+ *  The delays of the responders are set by the scenarios below: delay of the
+ *  fast replies, slow tail and losses of every module, and one module which can
+ *  be slower than the others.
+ *
+ *  Build and run from the root of the repository:
+ *      g++ -std=c++14 -O2 -Itests/stubs -I. -Itests tests/SweepBenchmark.cpp
+ *          tests/SimulatedBus.cpp Communication.cpp TimeoutEstimator.cpp DirtyLines.cpp
+ *          -o sweep_benchmark && ./sweep_benchmark
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "SimulatedBus.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SIM_TICKS           4000    // Ticks of every scenario (half serial, half pipelined)
+#define SIM_MODULES         5
+
+typedef struct Scenario
+{
+    const char *name;
+    SimModule module;               // Delays of every module
+    Address slowAddress;            // This module uses slowModule instead
+    SimModule slowModule;
+} Scenario;
+
+const Scenario scenarios[] = {
+    {"fast modules",        {OBC, 0, 3, 15, 0, 0, 0, 0},        EPS, {OBC, 0, 3, 15, 0, 0, 0, 0}},
+    {"slow tail, losses",   {OBC, 0, 3, 15, 10, 20, 90, 3},     EPS, {OBC, 0, 3, 15, 10, 20, 90, 3}},
+    {"one slow module",     {OBC, 0, 3, 15, 0, 0, 0, 0},        COMMS, {OBC, 0, 40, 80, 0, 0, 0, 0}},
+    {"all slow modules",    {OBC, 0, 40, 80, 10, 80, 99, 1},    EPS, {OBC, 0, 40, 80, 10, 80, 99, 1}}
+};
+
+const Address sweepAddresses[SIM_MODULES] = {ADB, ADCS, COMMS, EPS, PROP};
+const int sweepSizes[SIM_MODULES] = {26, 26, 66, 87, 26};
+
+// Container of the simulation, resolved at compile time like the real ones
+class SimContainer
+{
+public:
+    unsigned char array[96];
+    int arraySize;
+
+    unsigned char *getArray() { return array; }
+    int size() { return arraySize; }
+};
+
+SimContainer containers[SIM_MODULES];
+
+int CompareTime(const void *a, const void *b)
+{
+    unsigned long x = *(const unsigned long *)a;
+    unsigned long y = *(const unsigned long *)b;
+    return (x > y) - (x < y);
+}
+
+void PrintTime(const char *name, unsigned long *samples, int count, int replies)
+{
+    unsigned long sum = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        sum += samples[i];
+    }
+    qsort(samples, count, sizeof(unsigned long), CompareTime);
+    printf("    %-10s mean %6.1f  p50 %4lu  p90 %4lu  p99 %4lu  max %4lu ms, %.2f replies per sweep\n", name,
+           (double)sum / count, samples[count / 2], samples[count * 90 / 100], samples[count * 99 / 100],
+           samples[count - 1], (double)replies / count);
+}
+
+void RunScenario(const Scenario &scenario)
+{
+    static unsigned long serial[SIM_TICKS / 2];
+    static unsigned long pipelined[SIM_TICKS / 2];
+    int serialReplies = 0, pipelinedReplies = 0;
+    unsigned long start;
+    SimModule module;
+
+    SimReset();
+    for (int i = 0; i < SIM_MODULES; i++)
+    {
+        module = (sweepAddresses[i] == scenario.slowAddress) ? scenario.slowModule : scenario.module;
+        module.address = sweepAddresses[i];
+        module.telemetrySize = sweepSizes[i];
+        SimAddModule(module);
+        containers[i].arraySize = sweepSizes[i];
+    }
+
+    for (int tick = 0; tick < SIM_TICKS; tick++)
+    {
+        start = simNow;
+        CommunicationStartTick(COMMUNICATION_DEFAULT_BUDGET_MS);
+
+        if (tick % 2 == 0)
+        {
+            for (int i = 0; i < SIM_MODULES; i++)
+            {
+                serialReplies += RequestTelemetry(sweepAddresses[i], &containers[i]) == SERVICE_RESPONSE_REPLY;
+            }
+            serial[tick / 2] = simNow - start;
+        }
+        else
+        {
+            TelemetrySweepSlot sweep[SIM_MODULES];
+            for (int i = 0; i < SIM_MODULES; i++)
+            {
+                sweep[i] = TelemetrySweepSlotOf(sweepAddresses[i], containers[i]);
+            }
+            RequestTelemetrySweep(sweep, SIM_MODULES);
+            for (int i = 0; i < SIM_MODULES; i++)
+            {
+                pipelinedReplies += sweep[i].response == SERVICE_RESPONSE_REPLY;
+            }
+            pipelined[tick / 2] = simNow - start;
+        }
+        CommunicationEndTick();
+
+        // The late replies arrive before the next tick
+        for (int i = 0; i < 200; i++)
+        {
+            SimAdvance1ms();
+        }
+    }
+
+    printf("%s\n", scenario.name);
+    PrintTime("serial", serial, SIM_TICKS / 2, serialReplies);
+    PrintTime("pipelined", pipelined, SIM_TICKS / 2, pipelinedReplies);
+}
+
+int main()
+{
+    CommunicationInit();
+
+    for (unsigned int i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+    {
+        RunScenario(scenarios[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,249 @@
+/*
+ *  TelemetryLogTest.cpp
+ *
+ *  Host test of the compressed telemetry history (TelemetryCodec.cpp,
+ *  TelemetryLog.cpp and OBCFramLog.cpp run as is).
+ *
+ *  Round trip of the codec: random samples of random sizes, encoded against a
+ *  previous sample and as key frames, never exceed TELEMETRYCODEC_MAX_SIZE()
+ *  and are decoded to the same bytes.
+ *
+ *  Round trip of the log: the six containers are logged every tick into a small
+ *  FRAM which wraps around, with modules which don't reply, dropped FRAM writes
+ *  and resets. The log is then read back like the ground software does: every
+ *  decoded sample must be the logged one, and the samples which can't be decoded
+ *  (their previous sample was lost) must be limited by the key frames.
+ *
+ *  Build and run from the root of the repository:
+ *      g++ -std=c++14 -O2 -Itests/stubs -I. tests/TelemetryLogTest.cpp TelemetryLog.cpp
+ *          TelemetryCodec.cpp OBCFramLog.cpp Checksum.cpp -o telemetry_log_test && ./telemetry_log_test
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "TelemetryLog.h"
+#include "OBCFramAccess.h"
+#include "Checksum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CODEC_FRAMES        200000
+#define CODEC_MAX_SIZE      300
+#define LOG_TICKS           3000
+#define LOG_RECORDS         64      // Records of the simulated FRAM (OBCFRAM_LOG_MIN_RECORDS)
+#define LOG_NO_REPLY        5       // % of samples of a module missing
+#define LOG_DROPPED_WRITE   1       // % of FRAM writes lost
+#define LOG_RESET_PERIOD    500     // Ticks between two resets
+
+// Containers of the simulation: bus address and size
+const unsigned char containerIds[TELEMETRYLOG_CONTAINERS] = {1, 2, 3, 4, 5, 6};
+const int containerSizes[TELEMETRYLOG_CONTAINERS] = {OBC_CONTAINER_SIZE, EPS_CONTAINER_SIZE, ADB_CONTAINER_SIZE,
+                                                     COMMS_CONTAINER_SIZE, ADCS_CONTAINER_SIZE, PROP_CONTAINER_SIZE};
+
+// Every sample logged, by tick and container (logged[tick][c][0] == 0: not logged)
+unsigned char logged[LOG_TICKS][TELEMETRYLOG_CONTAINERS][1 + TELEMETRYLOG_MAX_SAMPLE];
+
+// Simulated FRAM
+unsigned char framMemory[OBCFRAM_LOG_ADDR + LOG_RECORDS * OBCFRAM_LOG_RECORD_SIZE];
+int droppedWrites;
+
+bool MB85RS::ping()
+{
+    return true;
+}
+
+void MB85RS::read(unsigned int address, unsigned char *data, unsigned int size)
+{
+    memcpy(data, &framMemory[address], size);
+}
+
+void MB85RS::write(unsigned int address, unsigned char *data, unsigned int size)
+{
+    if ((rand() % 100) < LOG_DROPPED_WRITE)
+    {
+        droppedWrites++;
+        return;
+    }
+    memcpy(&framMemory[address], data, size);
+}
+
+unsigned long MB85RS::getSize()
+{
+    return sizeof(framMemory);
+}
+
+// driverlib stand-ins (Checksum.cpp uses its table without ChecksumInit())
+void MAP_CRC32_setSeed(uint32_t, uint_fast8_t) {}
+void MAP_CRC32_set8BitData(uint8_t, uint_fast8_t) {}
+uint32_t MAP_CRC32_getResult(uint_fast8_t) { return 0; }
+uint32_t MAP_CRC32_getResultReversed(uint_fast8_t) { return 0; }
+
+int CodecRoundTrip()
+{
+    static unsigned char previous[CODEC_MAX_SIZE], current[CODEC_MAX_SIZE], decoded[CODEC_MAX_SIZE];
+    static unsigned char encoded[TELEMETRYCODEC_MAX_SIZE(CODEC_MAX_SIZE)];
+    int failures = 0;
+    int size, length;
+    bool keyFrame;
+
+    for (int frame = 0; frame < CODEC_FRAMES; frame++)
+    {
+        // Few values, so the runs of unchanged bytes have every length
+        size = 1 + rand() % CODEC_MAX_SIZE;
+        keyFrame = (frame % 10) == 0;
+        for (int i = 0; i < size; i++)
+        {
+            previous[i] = rand() % 3;
+            current[i] = rand() % 3;
+        }
+
+        length = TelemetryEncode(keyFrame ? 0 : previous, current, size, encoded, TELEMETRYCODEC_MAX_SIZE(size));
+        if ((length == TELEMETRYCODEC_ERROR)
+            || (TelemetryDecode(keyFrame ? 0 : previous, encoded, length, decoded, size) != size)
+            || (memcmp(decoded, current, size) != 0))
+        {
+            failures++;
+        }
+    }
+
+    printf("codec: %d frames, %d failures\n", CODEC_FRAMES, failures);
+    return failures;
+}
+
+/**
+ *
+ *  Next sample of a container: the uptime counts, a few values move
+ *
+ */
+void NextSample(unsigned char *sample, int size, int tick)
+{
+    sample[0] = tick >> 24;
+    sample[1] = tick >> 16;
+    sample[2] = tick >> 8;
+    sample[3] = tick;
+    for (int i = 0; i < 3; i++)
+    {
+        sample[4 + rand() % (size - 4)] ^= 1 << (rand() % 3);
+    }
+}
+
+void LogTicks(MB85RS &fram)
+{
+    static unsigned char samples[TELEMETRYLOG_CONTAINERS][TELEMETRYLOG_MAX_SAMPLE];
+
+    OBCFramLogInit(fram);
+    TelemetryLogInit();
+
+    for (int tick = 0; tick < LOG_TICKS; tick++)
+    {
+        if ((tick > 0) && (tick % LOG_RESET_PERIOD == 0))
+        {
+            OBCFramLogInit(fram);
+            TelemetryLogInit();
+        }
+
+        for (int c = 0; c < TELEMETRYLOG_CONTAINERS; c++)
+        {
+            NextSample(samples[c], containerSizes[c], tick);
+            if ((rand() % 100) < LOG_NO_REPLY)
+            {
+                continue;
+            }
+            logged[tick][c][0] = 1;
+            memcpy(&logged[tick][c][1], samples[c], containerSizes[c]);
+            TelemetryLogAppend(fram, tick, containerIds[c], samples[c], containerSizes[c]);
+        }
+        TelemetryLogFlush(fram);
+    }
+}
+
+int LogRoundTrip(MB85RS &fram)
+{
+    static unsigned char payload[OBCFRAM_LOG_MAX_PAYLOAD];
+    static unsigned char previous[TELEMETRYLOG_CONTAINERS][TELEMETRYLOG_MAX_SAMPLE];
+    bool known[TELEMETRYLOG_CONTAINERS] = {false};
+    int decoded = 0, undecodable = 0, failures = 0, oldest = LOG_TICKS, samples = 0;
+    unsigned long time;
+    unsigned char id, *encoded;
+    bool keyFrame;
+    int size, sampleSize, length, offset, c;
+
+    LogTicks(fram);
+
+    for (unsigned long index = 0; index < OBCFramLogCount(); index++)
+    {
+        // A lost record breaks the chain of every container
+        if ((OBCFramLogRead(fram, index, &time, &id, payload, &size) != FRAM_OPERATION_SUCCESS)
+            || (id != TELEMETRYLOG_ID))
+        {
+            memset(known, 0, sizeof(known));
+            continue;
+        }
+        if ((int)time < oldest)
+        {
+            oldest = time;
+        }
+
+        for (offset = 0; offset < size; )
+        {
+            offset = TelemetryLogNext(payload, size, offset, &id, &keyFrame, &sampleSize, &encoded, &length);
+            for (c = 0; (c < TELEMETRYLOG_CONTAINERS) && (containerIds[c] != id); c++);
+            if ((offset == TELEMETRYCODEC_ERROR) || (c == TELEMETRYLOG_CONTAINERS) || (sampleSize != containerSizes[c]))
+            {
+                failures++;
+                break;
+            }
+            if (!keyFrame && !known[c])
+            {
+                undecodable++;
+                continue;
+            }
+
+            if ((TelemetryDecode(keyFrame ? 0 : previous[c], encoded, length, previous[c], sampleSize) != sampleSize)
+                || (logged[time][c][0] == 0) || (memcmp(previous[c], &logged[time][c][1], sampleSize) != 0))
+            {
+                failures++;
+                known[c] = false;
+                continue;
+            }
+            known[c] = true;
+            decoded++;
+        }
+    }
+
+    for (int tick = oldest; tick < LOG_TICKS; tick++)
+    {
+        for (c = 0; c < TELEMETRYLOG_CONTAINERS; c++)
+        {
+            samples += logged[tick][c][0];
+        }
+    }
+
+    printf("log: %lu records for the last %d ticks (%.2f per tick instead of %d), %d dropped writes\n",
+           OBCFramLogCount(), LOG_TICKS - oldest, (double)OBCFramLogCount() / (LOG_TICKS - oldest),
+           TELEMETRYLOG_CONTAINERS, droppedWrites);
+    printf("     %d of %d samples decoded, %d waiting for a key frame, %d failures\n",
+           decoded, samples, undecodable, failures);
+
+    // Without a lost record, the decoding can only wait for the first key frame of each container
+    if (undecodable > (droppedWrites + 1) * TELEMETRYLOG_CONTAINERS * TELEMETRYLOG_KEY_PERIOD)
+    {
+        failures++;
+    }
+    return failures;
+}
+
+int main()
+{
+    MB85RS fram;
+    int failures;
+
+    srand(1);
+    failures = CodecRoundTrip();
+    failures += LogRoundTrip(fram);
+
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+    return (failures == 0) ? 0 : 1;
+}
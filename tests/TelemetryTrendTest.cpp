@@ -0,0 +1,161 @@
+/*
+ *  TelemetryTrendTest.cpp
+ *
+ *  Host test of the reductions of TelemetryTrend.cpp (run as is) on the samples
+ *  StateMachine() appends: every TREND_PERIOD seconds, the battery of EPS
+ *  discharging in eclipse then charging in the sun (with the noise of the ADC),
+ *  the bus voltage and the temperature of the OBC. Some samples are missing
+ *  (EPS didn't reply), so the times aren't evenly spaced.
+ *
+ *  After every sample, TrendMin(), TrendMax(), TrendMean() and TrendSlope() of
+ *  every series and every window (0 to TREND_SAMPLES + 1) are checked against a
+ *  plain computation over the same samples in double, also once the ring wraps
+ *  around. The slope of the battery voltage over the whole ring must also be
+ *  close to the simulated discharge rate at the end of an eclipse.
+ *
+ *  Build and run from the root of the repository:
+ *      g++ -std=c++14 -O2 -Itests/stubs -I. tests/TelemetryTrendTest.cpp TelemetryTrend.cpp
+ *          -o telemetry_trend_test && ./telemetry_trend_test
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "TelemetryTrend.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_SAMPLES        1000
+#define TEST_ORBIT          5400    // Seconds of an orbit, the first 2100 in eclipse
+#define TEST_ECLIPSE        2100
+#define TEST_DISCHARGE      -0.25   // mV per second in eclipse
+#define TEST_CHARGE         0.2     // mV per second in the sun
+#define TEST_NO_REPLY       5       // % of samples missing
+
+// Every sample appended, newest last
+unsigned long times[TEST_SAMPLES];
+signed short values[TEST_SAMPLES][TREND_SERIES];
+int count;
+
+signed short Noise(int amplitude)
+{
+    return (signed short)(rand() % (2 * amplitude + 1) - amplitude);
+}
+
+// The samples of StateMachine() at a time
+void Sample(unsigned long time, signed short *sample)
+{
+    unsigned long phase = time % TEST_ORBIT;
+    double battery;
+
+    if (phase < TEST_ECLIPSE)
+    {
+        battery = 7600 + TEST_DISCHARGE * phase;
+        sample[TREND_BATT_CURRENT] = -450 + Noise(20);
+    }
+    else
+    {
+        battery = 7600 + TEST_DISCHARGE * TEST_ECLIPSE + TEST_CHARGE * (phase - TEST_ECLIPSE);
+        sample[TREND_BATT_CURRENT] = 300 + Noise(20);
+    }
+    sample[TREND_BATT_VOLTAGE] = (signed short)battery + Noise(3);
+    sample[TREND_BUS_VOLTAGE] = 3300 + Noise(4);
+    sample[TREND_TEMPERATURE] = (signed short)(150 + 100 * sin(phase * 2 * M_PI / TEST_ORBIT)) + Noise(1);
+}
+
+// The reductions of the last window samples, in double
+void Reference(int series, int window, double *min, double *max, double *mean, double *slope)
+{
+    double sumT = 0, sumV = 0, sumTT = 0, sumTV = 0, t, v, denominator;
+
+    *min = *max = *mean = *slope = 0;
+    if (window > count)
+    {
+        window = count;
+    }
+    if (window == 0)
+    {
+        return;
+    }
+    *min = 32767;
+    *max = -32768;
+    for (int i = count - window; i < count; i++)
+    {
+        t = (double)times[i] - (double)times[count - 1];
+        v = values[i][series];
+        *min = (v < *min) ? v : *min;
+        *max = (v > *max) ? v : *max;
+        sumT += t;
+        sumV += v;
+        sumTT += t * t;
+        sumTV += t * v;
+    }
+    *mean = sumV / window;
+    denominator = window * sumTT - sumT * sumT;
+    if ((window >= 2) && (denominator != 0))
+    {
+        *slope = (window * sumTV - sumT * sumV) / denominator;
+    }
+}
+
+int main()
+{
+    double min, max, mean, slope, worstMean = 0, worstSlope = 0, ringSlope = 0;
+    unsigned long time = 0;
+    int failures = 0, checks = 0;
+    bool checkedEclipse = false;
+
+    if ((TrendCount() != 0) || (TrendMin(TREND_BATT_VOLTAGE, 4) != 0) || (TrendSlope(TREND_BATT_VOLTAGE, 4) != 0))
+    {
+        failures++;
+    }
+
+    while (count < TEST_SAMPLES)
+    {
+        time += TREND_PERIOD;
+        if ((rand() % 100) < TEST_NO_REPLY)
+        {
+            continue;
+        }
+        Sample(time, values[count]);
+        times[count] = time;
+        count++;
+        TrendAppend(time, values[count - 1]);
+
+        failures += TrendCount() != ((count < TREND_SAMPLES) ? count : TREND_SAMPLES);
+        for (int series = 0; series < TREND_SERIES; series++)
+        {
+            for (int window = 0; window <= TREND_SAMPLES + 1; window++)
+            {
+                Reference(series, (window < TREND_SAMPLES) ? window : TREND_SAMPLES, &min, &max, &mean, &slope);
+                if ((TrendMin((TrendSeries)series, window) != min) || (TrendMax((TrendSeries)series, window) != max)
+                    || (fabs(TrendMean((TrendSeries)series, window) - mean) > 1e-3 * (1 + fabs(mean)))
+                    || (fabs(TrendSlope((TrendSeries)series, window) - slope) > 1e-3 * (1 + fabs(slope))))
+                {
+                    failures++;
+                }
+                worstMean = fmax(worstMean, fabs(TrendMean((TrendSeries)series, window) - mean));
+                worstSlope = fmax(worstSlope, fabs(TrendSlope((TrendSeries)series, window) - slope));
+                checks++;
+            }
+        }
+
+        // At the end of an eclipse the whole ring is in the discharge
+        if (!checkedEclipse && (count > TREND_SAMPLES) && (time % TEST_ORBIT >= TEST_ECLIPSE - TREND_PERIOD)
+            && (time % TEST_ORBIT < TEST_ECLIPSE))
+        {
+            ringSlope = TrendSlope(TREND_BATT_VOLTAGE, TREND_SAMPLES);
+            checkedEclipse = true;
+        }
+    }
+
+    printf("%d samples, %d reductions checked, %d failures\n", TEST_SAMPLES, checks, failures);
+    printf("largest difference with the reference: mean %.2g, slope %.2g per second\n", worstMean, worstSlope);
+    printf("slope of the battery voltage at the end of an eclipse: %.3f mV/s (simulated %.3f)\n", ringSlope,
+           TEST_DISCHARGE);
+    failures += !checkedEclipse || (fabs(ringSlope - TEST_DISCHARGE) > 0.02);
+
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+/*
+ *  TimeoutEstimatorTest.cpp
+ *
+ *  Host test of the time limits given by TimeoutEstimator.cpp for simulated
+ *  distributions of the round-trip time of a service. Every request draws a
+ *  round-trip time (or no reply), then:
+ *      cut         the reply came after the time limit (counted as a timeout)
+ *      wait        time spent waiting: the round-trip time, or the time limit
+ *                  when the request is cut or gets no reply
+ *  and the distribution of the time limits is printed next to the fixed limit
+ *  of the baseline (100ms for the housekeeping).
+ *
+ *  Checks: the time limit stays between the floor and the limit of the caller, a
+ *  module which never replied keeps the limit of the caller, fewer than 2% of the
+ *  replies of a stable distribution are cut, and after a step of the round-trip
+ *  time at most 4 replies are cut before the estimation follows.
+ *
+ *  Build and run from the root of the repository:
+ *      g++ -std=c++14 -O2 -Itests/stubs -I. tests/TimeoutEstimatorTest.cpp TimeoutEstimator.cpp
+ *          -o timeout_estimator_test && ./timeout_estimator_test
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#include "TimeoutEstimator.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_REQUESTS       20000
+#define TEST_MAX_MS         100     // Fixed time limit of the housekeeping in the baseline
+#define TEST_FLOOR_MS       10
+#define TEST_CEILING_MS     1000
+#define NO_REPLY            0xFFFFFFFFUL
+
+typedef unsigned long (*Distribution)(int request);
+
+unsigned long TestRandom()
+{
+    static unsigned long long state = 0x2545F4914F6CDD1DULL;
+
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unsigned long)(state >> 33);
+}
+
+// 5 ~ 15ms
+unsigned long Uniform(int)
+{
+    return 5 + TestRandom() % 11;
+}
+
+// 4 ~ 12ms, 5% of 30 ~ 90ms
+unsigned long SlowTail(int)
+{
+    return ((TestRandom() % 100) < 5) ? 30 + TestRandom() % 61 : 4 + TestRandom() % 9;
+}
+
+// 5 ~ 15ms with 10% lost
+unsigned long Lossy(int)
+{
+    return ((TestRandom() % 100) < 10) ? NO_REPLY : 5 + TestRandom() % 11;
+}
+
+// 5 ~ 10ms, then 40 ~ 50ms from the middle of the run
+unsigned long Step(int request)
+{
+    return (request < TEST_REQUESTS / 2) ? 5 + TestRandom() % 6 : 40 + TestRandom() % 11;
+}
+
+// Never replies
+unsigned long Silent(int)
+{
+    return NO_REPLY;
+}
+
+typedef struct TestCase
+{
+    const char *name;
+    Distribution distribution;
+    Address destination;
+    int maxCutPermille;             // Replies cut (per 1000), -1: not checked
+} TestCase;
+
+const TestCase testCases[] = {
+    {"uniform 5~15ms",         Uniform,    ADB,    20},
+    {"slow tail 5%",           SlowTail,   ADCS,   -1},
+    {"10% lost",               Lossy,      COMMS,  20},
+    {"step 5~10 -> 40~50ms",   Step,       EPS,    20},
+    {"silent",                 Silent,     PROP,   -1}
+};
+
+int CompareMS(const void *a, const void *b)
+{
+    unsigned long x = *(const unsigned long *)a;
+    unsigned long y = *(const unsigned long *)b;
+    return (x > y) - (x < y);
+}
+
+int RunCase(const TestCase &test)
+{
+    static unsigned long limits[TEST_REQUESTS];
+    unsigned long limit, rtt, waitMS = 0, baselineMS = 0, replies = 0, cut = 0, stepCut = 0;
+    int failures = 0;
+
+    TimeoutSetLimits(test.destination, 3, TEST_FLOOR_MS, TEST_CEILING_MS);
+
+    for (int i = 0; i < TEST_REQUESTS; i++)
+    {
+        limit = TimeoutGetLimit(test.destination, 3, TEST_MAX_MS);
+        limits[i] = limit;
+        rtt = test.distribution(i);
+
+        if ((limit > TEST_MAX_MS) || ((limit < TEST_FLOOR_MS) && (limit != TEST_MAX_MS)))
+        {
+            failures++;
+        }
+
+        // Like CompleteRequest(): a reply in time updates the estimation, otherwise it backs off
+        baselineMS += (rtt <= TEST_MAX_MS) ? rtt : TEST_MAX_MS;
+        if (rtt == NO_REPLY)
+        {
+            waitMS += limit;
+            TimeoutExpired(test.destination, 3);
+            continue;
+        }
+        replies++;
+        if (rtt > limit)
+        {
+            waitMS += limit;
+            cut++;
+            if ((i >= TEST_REQUESTS / 2) && (i < TEST_REQUESTS / 2 + 20))
+            {
+                stepCut++;
+            }
+            TimeoutExpired(test.destination, 3);
+            continue;
+        }
+        waitMS += rtt;
+        TimeoutUpdate(test.destination, 3, rtt);
+    }
+
+    qsort(limits, TEST_REQUESTS, sizeof(unsigned long), CompareMS);
+    printf("%-22s limit p50 %4lu p90 %4lu p99 %4lu max %4lu ms, cut %5.2f%%, wait %6.1f ms (fixed %d ms: %6.1f)\n",
+           test.name, limits[TEST_REQUESTS / 2], limits[TEST_REQUESTS * 90 / 100],
+           limits[TEST_REQUESTS * 99 / 100], limits[TEST_REQUESTS - 1],
+           (replies > 0) ? 100.0 * cut / replies : 0.0, (double)waitMS / TEST_REQUESTS,
+           TEST_MAX_MS, (double)baselineMS / TEST_REQUESTS);
+
+    if ((test.maxCutPermille >= 0) && (cut * 1000 > (unsigned long)test.maxCutPermille * replies))
+    {
+        failures++;
+    }
+    // After the step, the backoff doubles the limit until the replies fit again
+    if ((test.distribution == Step) && (stepCut > 4))
+    {
+        failures++;
+    }
+    // Without any reply the limit stays the worst case of the caller
+    if ((test.distribution == Silent) && (limits[0] != TEST_MAX_MS))
+    {
+        failures++;
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = 0;
+
+    for (unsigned int i = 0; i < sizeof(testCases) / sizeof(testCases[0]); i++)
+    {
+        failures += RunCase(testCases[i]);
+    }
+
+    printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+    return (failures == 0) ? 0 : 1;
+}
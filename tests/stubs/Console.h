@@ -0,0 +1,17 @@
+/*
+ *  Console.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef CONSOLE_H_
+#define CONSOLE_H_
+
+class Console
+{
+public:
+    static void log(const char *, ...) {}
+};
+
+#endif /* CONSOLE_H_ */
@@ -0,0 +1,16 @@
+/*
+ *  DSPI.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef DSPI_H_
+#define DSPI_H_
+
+// Only the type: the devices on the bus (e.g. SDCard) are defined by the test
+class DSPI
+{
+};
+
+#endif /* DSPI_H_ */
@@ -0,0 +1,24 @@
+/*
+ *  DataFrame.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef DATAFRAME_H_
+#define DATAFRAME_H_
+
+class DataFrame
+{
+public:
+    virtual ~DataFrame() {}
+    virtual void setDestination(unsigned char destination) = 0;
+    virtual unsigned char getDestination() = 0;
+    virtual void setSource(unsigned char source) = 0;
+    virtual unsigned char getSource() = 0;
+    virtual void setPayloadSize(unsigned char size) = 0;
+    virtual unsigned char getPayloadSize() = 0;
+    virtual unsigned char *getPayload() = 0;
+};
+
+#endif /* DATAFRAME_H_ */
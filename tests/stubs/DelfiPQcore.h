@@ -0,0 +1,15 @@
+/*
+ *  DelfiPQcore.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef DELFIPQCORE_H_
+#define DELFIPQCORE_H_
+
+#include "driverlib.h"
+
+#define FCLOCK  48000000
+
+#endif /* DELFIPQCORE_H_ */
@@ -0,0 +1,21 @@
+/*
+ *  MB85RS.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef MB85RS_H_
+#define MB85RS_H_
+
+// The memory is defined by the test
+class MB85RS
+{
+public:
+    bool ping();
+    void read(unsigned int address, unsigned char *data, unsigned int size);
+    void write(unsigned int address, unsigned char *data, unsigned int size);
+    unsigned long getSize();
+};
+
+#endif /* MB85RS_H_ */
@@ -0,0 +1,19 @@
+/*
+ *  PQ9Bus.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef PQ9BUS_H_
+#define PQ9BUS_H_
+
+#include "PQ9Frame.h"
+
+class PQ9Bus
+{
+public:
+    void transmit(DataFrame &frame);    // Defined by the test
+};
+
+#endif /* PQ9BUS_H_ */
@@ -0,0 +1,31 @@
+/*
+ *  PQ9Frame.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef PQ9FRAME_H_
+#define PQ9FRAME_H_
+
+#include "DataFrame.h"
+
+class PQ9Frame : public DataFrame
+{
+protected:
+    unsigned char destination;
+    unsigned char source;
+    unsigned char size;
+    unsigned char payload[255];
+
+public:
+    void setDestination(unsigned char d) { destination = d; }
+    unsigned char getDestination() { return destination; }
+    void setSource(unsigned char s) { source = s; }
+    unsigned char getSource() { return source; }
+    void setPayloadSize(unsigned char s) { size = s; }
+    unsigned char getPayloadSize() { return size; }
+    unsigned char *getPayload() { return payload; }
+};
+
+#endif /* PQ9FRAME_H_ */
@@ -0,0 +1,19 @@
+/*
+ *  ResetService.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef RESETSERVICE_H_
+#define RESETSERVICE_H_
+
+class ResetService
+{
+public:
+    void kickInternalWatchDog() {}
+    void kickExternalWatchDog() {}
+    void refreshConfiguration() {}
+};
+
+#endif /* RESETSERVICE_H_ */
@@ -0,0 +1,17 @@
+/*
+ *  Task.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef TASK_H_
+#define TASK_H_
+
+class Task
+{
+public:
+    void notify() {}
+};
+
+#endif /* TASK_H_ */
@@ -0,0 +1,18 @@
+/*
+ *  TelemetryContainer.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef TELEMETRYCONTAINER_H_
+#define TELEMETRYCONTAINER_H_
+
+class TelemetryContainer
+{
+public:
+    virtual int size() = 0;
+    virtual unsigned char *getArray() = 0;
+};
+
+#endif /* TELEMETRYCONTAINER_H_ */
@@ -0,0 +1,45 @@
+/*
+ *  driverlib.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef DRIVERLIB_H_
+#define DRIVERLIB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TIMER32_0_BASE          0
+#define TIMER32_1_BASE          1
+#define TIMER32_PRESCALER_1     0
+#define TIMER32_32BIT           1
+#define TIMER32_PERIODIC_MODE   1
+#define TIMER32_FREE_RUN_MODE   0
+#define TIMER32_1_INTERRUPT     27
+#define CRC32_MODE              1
+#define CRC16_MODE              0
+#define GPIO_PORT_P1            1
+#define GPIO_PIN0               1
+#define GPIO_PIN1               2
+
+void MAP_Timer32_initModule(uint32_t timer, uint32_t prescaler, uint32_t resolution, uint32_t mode);
+void MAP_Timer32_setCount(uint32_t timer, uint32_t count);
+void MAP_Timer32_startTimer(uint32_t timer, bool oneShot);
+void MAP_Timer32_haltTimer(uint32_t timer);
+void MAP_Timer32_clearInterruptFlag(uint32_t timer);
+void MAP_Timer32_enableInterrupt(uint32_t timer);
+void MAP_Timer32_registerInterrupt(uint32_t interrupt, void (*handler)(void));
+bool MAP_Interrupt_disableMaster(void);
+bool MAP_Interrupt_enableMaster(void);
+bool MAP_PCM_gotoLPM0(void);
+void MAP_CRC32_setSeed(uint32_t seed, uint_fast8_t mode);
+void MAP_CRC32_set8BitData(uint8_t data, uint_fast8_t mode);
+uint32_t MAP_CRC32_getResult(uint_fast8_t mode);
+uint32_t MAP_CRC32_getResultReversed(uint_fast8_t mode);
+
+// Like the CMSIS intrinsic: a barrier for the compiler and the memory accesses
+inline void __DMB() { __sync_synchronize(); }
+
+#endif /* DRIVERLIB_H_ */
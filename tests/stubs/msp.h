@@ -0,0 +1,13 @@
+/*
+ *  msp.h (host stand-in)
+ *
+ *  Created on: 17 Oct 2026
+ *      Author: agent
+ */
+
+#ifndef MSP_H_
+#define MSP_H_
+
+#include "driverlib.h"
+
+#endif /* MSP_H_ */